@@ -0,0 +1,93 @@
+#ifndef AnalyticPrices_HPP
+#define AnalyticPrices_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "JumpDiffusion.hpp"
+#include "OptionData.hpp"
+
+// Closed-form reference prices under GBM, used to validate simulations
+
+inline double NormalCDF(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+// European call/put (o.type) with continuous dividend yield o.D
+inline double BlackScholesPrice(const OptionData& o) {
+    const double sqT = o.sig * std::sqrt(o.T);
+    const double d1 = (std::log(o.S_0 / o.K) + (o.r - o.D + 0.5 * o.sig * o.sig) * o.T) / sqT;
+    const double d2 = d1 - sqT;
+    const double dfr = std::exp(-o.r * o.T);
+    const double dfq = std::exp(-o.D * o.T);
+    if (o.type == -1) {
+        return o.K * dfr * NormalCDF(-d2) - o.S_0 * dfq * NormalCDF(-d1);
+    }
+    return o.S_0 * dfq * NormalCDF(d1) - o.K * dfr * NormalCDF(d2);
+}
+
+// Merton jump-diffusion European as the series of Black-Scholes prices with
+// vol sqrt(sig^2 + n volLog^2 / T) and rate r - lambda kappa + n ln(1 + kappa) / T,
+// weighted by Poisson(lambda (1 + kappa) T) probabilities of n jumps.
+// Terms are summed until their weight falls below tol.
+inline double MertonJumpPrice(const OptionData& o, const JumpCoefficients& jumps, double tol = 1e-14) {
+    if (jumps.model != JumpModel::Merton) {
+        throw std::runtime_error("Series price needs lognormal (Merton) jumps");
+    }
+    const double kappa = jumps.Compensator();
+    const double lambdaT = jumps.intensity * (1.0 + kappa) * o.T;
+    double weight = std::exp(-lambdaT);   // Poisson(lambdaT) probability of n
+    double price = 0.0;
+    for (int n = 0; n < 1000; ++n) {
+        const double jumpsN = static_cast<double>(n);
+        OptionData term = o;
+        term.sig = std::sqrt(o.sig * o.sig + jumpsN * jumps.volLog * jumps.volLog / o.T);
+        term.r = o.r - jumps.intensity * kappa + jumpsN * std::log1p(kappa) / o.T;
+        price += weight * BlackScholesPrice(term);
+        weight *= lambdaT / (jumpsN + 1.0);
+        if (jumpsN > lambdaT && weight < tol) break;
+    }
+    return price;
+}
+
+// Discretely monitored geometric-average Asian call/put: the average of
+// log S over the (ascending) fixing times, which is normal under GBM
+inline double GeometricAsianPrice(const OptionData& o, const std::vector<double>& fixings) {
+    const auto n = static_cast<double>(fixings.size());
+    double meanT = 0.0;
+    double sumMin = 0.0;   // sum_{i,j} min(t_i, t_j)
+    for (size_t i = 0; i < fixings.size(); ++i) {
+        meanT += fixings[i] / n;
+        sumMin += fixings[i] * static_cast<double>(2 * (fixings.size() - 1 - i) + 1);
+    }
+    const double m = std::log(o.S_0) + (o.r - o.D - 0.5 * o.sig * o.sig) * meanT;
+    const double v = o.sig * o.sig * sumMin / (n * n);
+    const double df = std::exp(-o.r * o.T);
+    const double lnK = std::log(o.K);
+
+    if (v <= 0.0) {
+        const double g = std::exp(m);
+        return df * std::max(0.0, o.type == -1 ? o.K - g : g - o.K);
+    }
+    const double sd = std::sqrt(v);
+    const double d2 = (m - lnK) / sd;
+    const double d1 = d2 + sd;
+    const double forward = std::exp(m + 0.5 * v);
+    if (o.type == -1) {
+        return df * (o.K * NormalCDF(-d2) - forward * NormalCDF(-d1));
+    }
+    return df * (forward * NormalCDF(d1) - o.K * NormalCDF(d2));
+}
+
+// Fixings of AsianOptionPricer's default average on a uniform grid: every
+// grid point but the last, t_i = i T / NT for i < NT
+inline std::vector<double> UniformAsianFixings(double T, int NT) {
+    std::vector<double> t;
+    for (int i = 0; i < NT; ++i) {
+        t.push_back(T * static_cast<double>(i) / static_cast<double>(NT));
+    }
+    return t;
+}
+
+#endif
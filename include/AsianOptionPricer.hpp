@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <vector>
+#include <span>
 #include <numeric>
 #include "Pricer.hpp"
 
@@ -12,13 +13,25 @@ public:
         : Pricer(po, dis)
     {}
 
-    void GeneratePath(const std::vector<double>& vec) override {
-        const double pathSum = std::accumulate(vec.begin(), vec.end() - 1, 0.0);
-        const double avg = pathSum / static_cast<double>(vec.size() - 1);
-        const double payoff = m_payoffFunction(avg);
+    void GeneratePath(std::span<const double> vec) override {
+        const double payoff = m_payoffFunction(PathAverage(vec, m_observations));
         updateStats(payoff);
     }
 
+    // Arithmetic average over the observation dates; without a schedule every
+    // point but the last is averaged
+    static double PathAverage(std::span<const double> vec, const std::vector<size_t>& observations) {
+        if (observations.empty()) {
+            const double pathSum = std::accumulate(vec.begin(), vec.end() - 1, 0.0);
+            return pathSum / static_cast<double>(vec.size() - 1);
+        }
+        double pathSum = 0.0;
+        for (size_t idx : observations) {
+            pathSum += vec[idx];
+        }
+        return pathSum / static_cast<double>(observations.size());
+    }
+
     void AfterPathCleanUp() override {}
 };
 
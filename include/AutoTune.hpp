@@ -0,0 +1,79 @@
+#ifndef AutoTune_HPP
+#define AutoTune_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "JobScheduler.hpp"
+#include "Precision.hpp"
+
+// Per-host execution parameters chosen by short calibration runs.
+//
+// The build targets -march=native, but the best path block size, RNG batch,
+// kernel width and thread count still differ between CPU generations (cache
+// sizes, vector width, SMT). AutoTune times a small GBM workload through
+// MCCentralHub for each candidate, one parameter at a time, and JobScheduler
+// for the thread count. The result is saved as a small text file keyed by a
+// host fingerprint; LoadOrTune reads it back without measuring anything and
+// retunes only when the file is missing or was made on a different host.
+
+struct AutoTuneOptions {
+    // float32 kernels vectorise at twice the width but change prices in the
+    // last digits, so they are only a candidate when allowed
+    bool allowSinglePrecision{false};
+    unsigned maxWorkers{0};        // 0 = every CPU the process may run on
+    int steps{64};                 // time steps of the calibration workload
+    std::int64_t paths{16384};     // paths per single-thread measurement
+    int reps{3};                   // best of reps per candidate
+};
+
+struct TuneProfile {
+    std::string host;                         // HostFingerprint() of the tuned host
+    size_t kernelBlockSize{256};              // MCCentralHub::SetBlockSize
+    size_t rngBatch{1};                       // MCCentralHub::SetRngBatch
+    Precision precision{Precision::Double};   // kernel variant: float64 or float32 blocks
+    unsigned workers{1};
+    std::int64_t pathsPerBlock{4096};         // JobScheduler task granularity
+    double stepsPerSecond{0.0};               // path steps/s of the tuned setup, all workers
+
+    JobScheduler::Config SchedulerConfig() const {
+        JobScheduler::Config cfg;
+        cfg.workers = workers;
+        cfg.pathsPerBlock = pathsPerBlock;
+        cfg.kernelBlockSize = kernelBlockSize;
+        cfg.rngBatch = rngBatch;
+        cfg.precision = precision;
+        return cfg;
+    }
+
+    template <typename Hub>
+    void Apply(Hub& hub) const {
+        hub.SetBlockSize(kernelBlockSize);
+        hub.SetRngBatch(rngBatch);
+        hub.SetPrecision(precision);
+    }
+
+    std::string Describe() const;
+};
+
+// CPU model and number of usable CPUs, e.g. "AMD EPYC 7763 64-Core Processor x16"
+std::string HostFingerprint();
+
+// Runs the calibration on this host; takes a fraction of a second per worker count
+TuneProfile AutoTune(const AutoTuneOptions& options = {});
+
+// Save throws std::runtime_error on I/O errors. Load returns nullopt if the
+// file does not exist and throws if it is not a tune profile.
+void SaveTuneProfile(const std::string& path, const TuneProfile& profile);
+std::optional<TuneProfile> LoadTuneProfile(const std::string& path);
+
+// $MC_TUNE_PROFILE, else $XDG_CACHE_HOME/monte_carlo/tune_profile, else
+// ~/.cache/monte_carlo/tune_profile
+std::string DefaultTuneProfilePath();
+
+// The profile at path if it was tuned on this host, else a fresh AutoTune
+// that is saved there (a failed save is not an error; the next run retunes).
+// tuned, if given, reports which of the two happened.
+TuneProfile LoadOrTune(const std::string& path, const AutoTuneOptions& options = {}, bool* tuned = nullptr);
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef Calibration_HPP
+#define Calibration_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "NormalCache.hpp"
+#include "OptionData.hpp"
+#include "PricingProtocol.hpp"
+#include "SDEGeneral.hpp"
+
+// Fits model parameters to market option prices by Levenberg-Marquardt.
+//
+// Every model price is a block-mode MCCentralHub run on one NormalCache, so
+// all instruments and all iterations see the same normals. The objective is
+// then a deterministic, smooth function of the parameters instead of a noisy
+// one, finite-difference Jacobians are accurate at small bumps, and LM
+// converges in a handful of iterations. The pricings of one iteration (each
+// instrument at the point and at every bumped point) run in parallel.
+
+struct CalibrationInstrument {
+    OptionData option;        // contract and rates; the model sets the dynamics
+    PayoffStyle style{PayoffStyle::European};
+    double marketPrice{0.0};
+    double weight{1.0};       // residual = weight * (model - market)
+};
+
+struct CalibrationModel {
+    std::vector<std::string> names;
+    std::vector<double> initial;
+    std::vector<double> lower;
+    std::vector<double> upper;
+    // SDE of an instrument's underlying under parameters p
+    std::function<std::shared_ptr<SDEGeneral>(const OptionData&, const std::vector<double>& p)> build;
+};
+
+// GBM (or CEV at the instrument's betaCEV) with sig free
+CalibrationModel VolatilityModel(double initialSig);
+// CEV with sig and beta free
+CalibrationModel CEVModel(double initialSig, double initialBeta);
+
+struct CalibrationConfig {
+    std::int64_t paths{20000};
+    int steps{50};                       // uniform steps to each maturity
+    SchemeType scheme{SchemeType::PredictorCorrector};
+    std::uint64_t seed{1};               // of the cached normals
+    size_t blockSize{256};
+    unsigned workers{0};                 // 0 = hardware concurrency
+    std::string normalsFile;             // empty: normals in memory, else mapped from this file
+    int maxIterations{50};
+    double relativeBump{1e-4};           // central-difference step relative to the parameter
+    double tolerance{1e-10};             // on the relative step and the relative cost decrease
+};
+
+struct CalibrationResult {
+    std::vector<double> params;
+    std::vector<double> modelPrices;
+    double cost{0.0};                    // 0.5 * sum of squared residuals
+    int iterations{0};
+    std::int64_t pricings{0};            // instrument pricings, Jacobians included
+    bool converged{false};
+    bool stalled{false};                 // no damped step lowered the cost; not converged
+};
+
+class Calibrator {
+public:
+    // Draws (or maps) the normals once; throws std::runtime_error on an empty
+    // instrument list, inconsistent model bounds or blockSize 0
+    Calibrator(std::vector<CalibrationInstrument> instruments, CalibrationModel model, CalibrationConfig config = {});
+
+    // Model prices of every instrument at p, all on the cached normals
+    std::vector<double> Prices(const std::vector<double>& p);
+
+    CalibrationResult Run();
+
+    const NormalCache& Normals() const { return *normals; }
+
+private:
+    // Prices of every instrument at every parameter set, in parallel
+    std::vector<std::vector<double>> PriceAll(const std::vector<std::vector<double>>& paramSets);
+    double PriceOne(const CalibrationInstrument& instrument, const std::vector<double>& p) const;
+    std::vector<double> Clamp(std::vector<double> p) const;
+
+    std::vector<CalibrationInstrument> instruments;
+    CalibrationModel model;
+    CalibrationConfig cfg;
+    std::shared_ptr<const NormalCache> normals;
+    std::int64_t pricings{0};
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef CompositePricer_HPP
+#define CompositePricer_HPP
+
+#include <memory>
+#include <vector>
+#include <span>
+#include "Pricer.hpp"
+
+// Fans every simulated path out to several pricers, so payoffs on the same
+// underlying share one set of paths. The composite's own accumulators hold
+// the book payoff (the sum over the children), which is what the hub reports
+// to a SimulationControl.
+class CompositePricer : public Pricer {
+private:
+    std::vector<std::shared_ptr<Pricer>> pricers;
+
+public:
+    CompositePricer() = default;
+
+    explicit CompositePricer(std::vector<std::shared_ptr<Pricer>> children)
+        : pricers(std::move(children))
+    {}
+
+    void Add(std::shared_ptr<Pricer> child) {
+        pricers.push_back(std::move(child));
+    }
+
+    const std::vector<std::shared_ptr<Pricer>>& Children() const { return pricers; }
+
+    void GeneratePath(std::span<const double> vec) override {
+        for (auto& p : pricers) {
+            p->GeneratePath(vec);
+        }
+        updateStats(LastPayoff());
+    }
+
+    void AfterPathCleanUp() override {
+        for (auto& p : pricers) {
+            p->AfterPathCleanUp();
+        }
+    }
+
+    // The book's payoff: the sum over the children
+    double LastPayoff() const override {
+        double payoff = 0.0;
+        for (const auto& p : pricers) {
+            payoff += p->LastPayoff();
+        }
+        return payoff;
+    }
+
+    void SetPathWeight(double w) override {
+        Pricer::SetPathWeight(w);
+        for (auto& p : pricers) {
+            p->SetPathWeight(w);
+        }
+    }
+
+    void SetObservationIndices(const std::vector<size_t>& indices) override {
+        for (auto& p : pricers) {
+            p->SetObservationIndices(indices);
+        }
+    }
+};
+
+#endif
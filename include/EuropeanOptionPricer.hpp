@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <vector>
+#include <span>
 #include "Pricer.hpp"
 
 class EuropeanOptionPricer : public Pricer {
@@ -12,7 +13,7 @@ public:
         : Pricer(po, dis)
     {}
 
-    void GeneratePath(const std::vector<double>& vec) override {
+    void GeneratePath(std::span<const double> vec) override {
         const double payoff = m_payoffFunction(vec.back());
         updateStats(payoff);
     }
@@ -3,30 +3,50 @@
 
 #include "SDEGeneral.hpp"
 #include "FDMType.hpp"
+#include "PathKernels.hpp"
 
 class FDMEuler: public FDMType {
 public:
-    double dtSqrt;
+    FDMEuler(std::shared_ptr<SDEGeneral>& stochEqn, int numTimeSteps)
+        : FDMEuler(stochEqn, TimeGrid::Uniform(stochEqn->data->T, numTimeSteps))
+    {}
 
-    FDMEuler(std::shared_ptr<SDEGeneral>& stochEqn, int numTimeSteps) {
+    // Arbitrary (e.g. fixing-date) grid; dt varies per step
+    FDMEuler(std::shared_ptr<SDEGeneral>& stochEqn, const TimeGrid& grid) {
         sde = stochEqn;
-        NT = numTimeSteps;
-        m = sde->data->T / static_cast<double>(NT);
-        dtSqrt = std::sqrt(m);
-        x = std::vector<double>(static_cast<size_t>(NT) + 1);
-        x[0] = 0.0;
-        
-        // Fixed signed/unsigned comparison
-        for (size_t i = 1; i < x.size(); ++i) {
-            x[i] = x[i - 1] + m;
-        }
+        setGrid(grid);
     }
 
-    double next_n(double x_n, double t_n, double dt, double normVar, 
+    double next_n(double x_n, double t_n, double dt, double normVar,
                  [[maybe_unused]] double normVar2) override {
-        return (x_n + (sde->drift(t_n, x_n) * dt) + 
+        return (x_n + (sde->drift(t_n, x_n) * dt) +
                 (sde->diffusion(t_n, x_n) * normVar * std::sqrt(dt)));
     }
+
+    void next_block(double* xs, const double* normVars, size_t n, double t_n, double dt) override {
+        stepBlock(xs, normVars, n, t_n, dt);
+    }
+
+    void next_block(float* xs, const float* normVars, size_t n, double t_n, double dt) override {
+        stepBlock(xs, normVars, n, t_n, dt);
+    }
+
+private:
+    template <typename Real>
+    void stepBlock(Real* xs, const Real* normVars, size_t n, double t_n, double dt) {
+        if (sde->localVol) {
+            EulerBlockLocalVol<Real>(xs, normVars, n, *sde->localVol, t_n, dt);
+        }
+        else if (!sde->closedForm) {
+            FDMType::next_block(xs, normVars, n, t_n, dt);
+        }
+        else if (sde->closedForm->beta == 1.0) {
+            EulerBlockCEV<Real, true>(xs, normVars, n, *sde->closedForm, dt);
+        }
+        else {
+            EulerBlockCEV<Real, false>(xs, normVars, n, *sde->closedForm, dt);
+        }
+    }
 };
 
 #endif
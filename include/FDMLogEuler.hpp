@@ -0,0 +1,55 @@
+#ifndef FDMLogEuler_HPP
+#define FDMLogEuler_HPP
+
+#include "SDEGeneral.hpp"
+#include "FDMType.hpp"
+#include "PathKernels.hpp"
+
+// Euler on log S with the local drift mu(t, S) = drift / S and volatility
+// sigma(t, S) = diffusion / S frozen over the step:
+//     S_{n+1} = S_n exp((mu - sigma^2 / 2) dt + sigma sqrt(dt) Z)
+// Exact in distribution for GBM whatever dt, so coarse fixing-date grids
+// (12-52 steps) carry no discretisation bias there; paths stay positive.
+class FDMLogEuler: public FDMType {
+public:
+    FDMLogEuler(std::shared_ptr<SDEGeneral>& stochEqn, int numTimeSteps)
+        : FDMLogEuler(stochEqn, TimeGrid::Uniform(stochEqn->data->T, numTimeSteps))
+    {}
+
+    // Arbitrary (e.g. fixing-date) grid; dt varies per step
+    FDMLogEuler(std::shared_ptr<SDEGeneral>& stochEqn, const TimeGrid& grid) {
+        sde = stochEqn;
+        setGrid(grid);
+    }
+
+    double next_n(double x_n, double t_n, double dt, double normVar,
+                 [[maybe_unused]] double normVar2) override {
+        const double mu = sde->drift(t_n, x_n) / x_n;
+        const double sigma = sde->diffusion(t_n, x_n) / x_n;
+        return x_n * std::exp((mu - 0.5 * sigma * sigma) * dt + sigma * normVar * std::sqrt(dt));
+    }
+
+    void next_block(double* xs, const double* normVars, size_t n, double t_n, double dt) override {
+        stepBlock(xs, normVars, n, t_n, dt);
+    }
+
+    void next_block(float* xs, const float* normVars, size_t n, double t_n, double dt) override {
+        stepBlock(xs, normVars, n, t_n, dt);
+    }
+
+private:
+    template <typename Real>
+    void stepBlock(Real* xs, const Real* normVars, size_t n, double t_n, double dt) {
+        if (sde->localVol || !sde->closedForm) {
+            FDMType::next_block(xs, normVars, n, t_n, dt);
+        }
+        else if (sde->closedForm->beta == 1.0) {
+            LogEulerBlockCEV<Real, true>(xs, normVars, n, *sde->closedForm, dt);
+        }
+        else {
+            LogEulerBlockCEV<Real, false>(xs, normVars, n, *sde->closedForm, dt);
+        }
+    }
+};
+
+#endif
@@ -3,10 +3,10 @@
 
 #include "SDEGeneral.hpp"
 #include "FDMType.hpp"
+#include "PathKernels.hpp"
 
 class FDMPredictCorrect : public FDMType {
 public:
-    double dtSqrt;
     double A; // alpha
     double B; // beta
 
@@ -31,21 +31,24 @@ public:
     FDMPredictCorrect(std::shared_ptr<SDEGeneral>& stochEqn, int numTimeSteps, 
                       double alpha = 0.5, double beta = 0.5) {
         sde = stochEqn;
-        NT = numTimeSteps;
         A = alpha;
         B = beta;
         
         validateConstruction(numTimeSteps, alpha, beta);
         
-        m = sde->data->T / static_cast<double>(NT);
-        dtSqrt = std::sqrt(m);
-        x = std::vector<double>(static_cast<size_t>(NT) + 1);
-        x[0] = 0.0;
-        
-        // Fixed signed/unsigned comparison
-        for (size_t i = 1; i < x.size(); ++i) {
-            x[i] = x[i - 1] + m;
-        }
+        setGrid(TimeGrid::Uniform(sde->data->T, numTimeSteps));
+    }
+
+    // Arbitrary (e.g. fixing-date) grid; dt varies per step
+    FDMPredictCorrect(std::shared_ptr<SDEGeneral>& stochEqn, const TimeGrid& grid,
+                      double alpha = 0.5, double beta = 0.5) {
+        sde = stochEqn;
+        A = alpha;
+        B = beta;
+
+        validateConstruction(grid.NumSteps(), alpha, beta);
+
+        setGrid(grid);
     }
 
     double next_n(double x_n, double t_n, double dt, double normVar, 
@@ -62,6 +65,31 @@ public:
         
         return x_n + adjustedDriftTerm + diffusionTerm;
     }
+
+    void next_block(double* xs, const double* normVars, size_t n, double t_n, double dt) override {
+        stepBlock(xs, normVars, n, t_n, dt);
+    }
+
+    void next_block(float* xs, const float* normVars, size_t n, double t_n, double dt) override {
+        stepBlock(xs, normVars, n, t_n, dt);
+    }
+
+private:
+    template <typename Real>
+    void stepBlock(Real* xs, const Real* normVars, size_t n, double t_n, double dt) {
+        if (sde->localVol) {
+            PredictCorrectBlockLocalVol<Real>(xs, normVars, n, *sde->localVol, A, B, t_n, dt);
+        }
+        else if (!sde->closedForm) {
+            FDMType::next_block(xs, normVars, n, t_n, dt);
+        }
+        else if (sde->closedForm->beta == 1.0) {
+            PredictCorrectBlockCEV<Real, true>(xs, normVars, n, *sde->closedForm, A, B, dt);
+        }
+        else {
+            PredictCorrectBlockCEV<Real, false>(xs, normVars, n, *sde->closedForm, A, B, dt);
+        }
+    }
 };
 
 #endif
@@ -3,24 +3,80 @@
 
 #include <vector>
 #include <memory>
+#include <stdexcept>
 #include "SDEGeneral.hpp"
+#include "TimeGrid.hpp"
 
 class FDMType {
 protected:
     std::shared_ptr<SDEGeneral> sde;
     int NT;
     std::vector<double> x;
-    double m;
+    std::vector<double> dts;   // per-step dt, dts[j] = x[j + 1] - x[j]
+    std::vector<size_t> obs;   // observation (fixing) indices into x, empty if none
+    double m;                  // uniform step, or mean step on a non-uniform grid
+
+    void setGrid(const TimeGrid& grid) {
+        x = grid.Times();
+        dts = grid.Steps();
+        obs = grid.ObservationIndices();
+        NT = grid.NumSteps();
+        m = grid.Maturity() / static_cast<double>(NT);
+    }
 
 public:
     FDMType() = default;
     virtual ~FDMType() = default;
-    
+
     virtual double next_n(double x_n, double t_n, double dt, double normVar, double normVar2) = 0;
-    
+
+    // Advances n paths in place by one step. Schemes override these with
+    // batched kernels; the default falls back to next_n per path, in double.
+    virtual void next_block(double* xs, const double* normVars, size_t n, double t_n, double dt) {
+        for (size_t k = 0; k < n; ++k) {
+            xs[k] = next_n(xs[k], t_n, dt, normVars[k], 0.0);
+        }
+    }
+
+    virtual void next_block(float* xs, const float* normVars, size_t n, double t_n, double dt) {
+        for (size_t k = 0; k < n; ++k) {
+            xs[k] = static_cast<float>(next_n(static_cast<double>(xs[k]), t_n, dt,
+                                              static_cast<double>(normVars[k]), 0.0));
+        }
+    }
+
+    // Re-targets the scheme to NT equal steps on [0, T] in place, with the
+    // points TimeGrid::Uniform gives. The grid keeps its capacity, so a
+    // scheme reused for grids no longer than before does not allocate.
+    void setUniformGrid(double T, int numTimeSteps) {
+        if (numTimeSteps <= 0) {
+            throw std::runtime_error("Number of time steps must be positive");
+        }
+        if (T <= 0) {
+            throw std::runtime_error("Time period T must be positive");
+        }
+        const double step = T / static_cast<double>(numTimeSteps);
+        const auto n = static_cast<size_t>(numTimeSteps);
+        x.resize(n + 1);
+        dts.resize(n);
+        x[0] = 0.0;
+        for (size_t i = 1; i <= n; ++i) {
+            x[i] = x[i - 1] + step;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            dts[i] = x[i + 1] - x[i];
+        }
+        obs.clear();
+        NT = numTimeSteps;
+        m = x.back() / static_cast<double>(NT);
+    }
+
     // Getters for accessing protected members
     const std::vector<double>& getTimePoints() const { return x; }
     double getTimeStep() const { return m; }
+    double getTimeStep(size_t step) const { return dts[step]; }
+    const std::vector<double>& getTimeSteps() const { return dts; }
+    const std::vector<size_t>& getObservationIndices() const { return obs; }
     int getNumTimeSteps() const { return NT; }
     double getTimePoint(size_t index) const { return x[index]; }
 };
@@ -0,0 +1,40 @@
+#ifndef GeometricAsianPricer_HPP
+#define GeometricAsianPricer_HPP
+
+#include <cmath>
+#include <functional>
+#include <span>
+#include <vector>
+#include "Pricer.hpp"
+
+// Geometric-average counterpart of AsianOptionPricer over the same fixings;
+// it has a closed form under GBM (GeometricAsianPrice) and serves as a check
+// on the simulation and as a control variate for the arithmetic Asian
+class GeometricAsianPricer : public Pricer {
+public:
+    GeometricAsianPricer(std::function<double(double)>& po, std::function<double()>& dis)
+        : Pricer(po, dis)
+    {}
+
+    void GeneratePath(std::span<const double> vec) override {
+        updateStats(m_payoffFunction(PathAverage(vec, m_observations)));
+    }
+
+    static double PathAverage(std::span<const double> vec, const std::vector<size_t>& observations) {
+        double logSum = 0.0;
+        if (observations.empty()) {
+            for (size_t i = 0; i + 1 < vec.size(); ++i) {
+                logSum += std::log(vec[i]);
+            }
+            return std::exp(logSum / static_cast<double>(vec.size() - 1));
+        }
+        for (size_t idx : observations) {
+            logSum += std::log(vec[idx]);
+        }
+        return std::exp(logSum / static_cast<double>(observations.size()));
+    }
+
+    void AfterPathCleanUp() override {}
+};
+
+#endif
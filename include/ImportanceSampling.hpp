@@ -0,0 +1,95 @@
+#ifndef ImportanceSampling_HPP
+#define ImportanceSampling_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "MCCentralHub.hpp"
+#include "PricingEngine.hpp"
+
+// Choosing the Brownian drift shift theta for MCCentralHub::SetDriftShift.
+//
+// Analytic: the mode of the zero-variance density f(S_T(w)) phi(w / sqrt(T))
+// under GBM with the SDE's drift and vol frozen at (0, S_0); exact for GBM
+// Europeans and a good start for everything else.
+// Pilot: cross-entropy refinement from the analytic shift. Each iteration runs
+// pilotPaths shifted paths and moves theta to E[f L W_T] / (T E[f L]), the
+// mean of W_T under the zero-variance measure.
+
+enum class ShiftSelection { Fixed, Analytic, Pilot };
+
+struct ImportanceSamplingConfig {
+    ShiftSelection selection{ShiftSelection::Pilot};
+    double shift{0.0};                   // used by Fixed
+    std::int64_t pilotPaths{4000};
+    int pilotIterations{3};
+};
+
+// type: 1 == call, -1 == put, strike K
+inline double AnalyticDriftShift(const SDEGeneral& sde, double K, int type) {
+    const double T = sde.data->T;
+    const double S0 = sde.data->S_0;
+    const double mu = sde.drift(0.0, S0) / S0;
+    const double sig = sde.diffusion(0.0, S0) / S0;
+    if (!(sig > 0.0) || !(K > 0.0) || !(T > 0.0)) return 0.0;
+
+    const double a = (mu - 0.5 * sig * sig) * T;
+    const double wK = (std::log(K / S0) - a) / sig;   // S_T(wK) == K
+    auto ST = [&](double w) { return S0 * std::exp(a + sig * w); };
+    // d/dw [log f(S_T(w)) - w^2 / 2T]; decreasing on the in-the-money side
+    auto slope = [&](double w) {
+        const double s = ST(w);
+        return sig * s / (s - K) - w / T;
+    };
+
+    const double step = std::sqrt(T);
+    double inner = wK + (type == -1 ? -1e-9 : 1e-9) * (1.0 + std::abs(wK));
+    double outer = inner;
+    for (int i = 0; i < 200 && (type == -1 ? slope(outer) <= 0.0 : slope(outer) >= 0.0); ++i) {
+        outer += (type == -1 ? -step : step);
+    }
+    for (int i = 0; i < 200; ++i) {
+        const double mid = 0.5 * (inner + outer);
+        if ((slope(mid) > 0.0) == (type != -1)) inner = mid;
+        else outer = mid;
+    }
+    return 0.5 * (inner + outer) / T;
+}
+
+// Cross-entropy pilot on fresh pricers from makePricer; returns the last
+// shift if a pilot iteration sees no positive payoff
+inline double PilotDriftShift(std::shared_ptr<SDEGeneral> sde, std::shared_ptr<FDMType> fdm,
+                              const std::function<std::shared_ptr<Pricer>()>& makePricer,
+                              std::shared_ptr<MTEngRandNumGen> rng, double start,
+                              const ImportanceSamplingConfig& cfg) {
+    const double T = fdm->getTimePoints().back() - fdm->getTimePoints().front();
+    double theta = start;
+    for (int it = 0; it < cfg.pilotIterations; ++it) {
+        auto pricer = makePricer();
+        auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, cfg.pilotPaths);
+        hub.SetVerbose(false);
+        hub.SetBlockSize(256);
+        hub.SetDriftShift(theta);
+        hub.CollectShiftMoments(true);
+        hub.BeginSimulation();
+        const auto& m = hub.DriftShiftMoments();
+        if (!(m.weightedPayoff > 0.0)) break;
+        theta = m.weightedPayoffW / (T * m.weightedPayoff);
+    }
+    return theta;
+}
+
+// Shift for one pricing request under the configured selection rule
+inline double ChooseDriftShift(const PricingRequest& req, std::shared_ptr<MTEngRandNumGen> rng,
+                               const ImportanceSamplingConfig& cfg) {
+    if (cfg.selection == ShiftSelection::Fixed) return cfg.shift;
+    auto sde = MakeSDE(req.option);
+    const double analytic = AnalyticDriftShift(*sde, req.option.K, req.option.type);
+    if (cfg.selection == ShiftSelection::Analytic) return analytic;
+    auto fdm = MakeFDM(sde, req.scheme, req.NT);
+    return PilotDriftShift(sde, fdm, [&req] { return MakePricer(req); }, std::move(rng), analytic, cfg);
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef IncrementalRepricer_HPP
+#define IncrementalRepricer_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "AsianOptionPricer.hpp"
+#include "PathStatistics.hpp"
+#include "Pricer.hpp"
+#include "PricingEngine.hpp"
+#include "SDEGeneral.hpp"
+
+// Records the normalised samples S_T/S_0 and average/S_0 of every path. Use
+// it as the pricer of a normal run (or a path store replay) to feed an
+// IncrementalRepricer.
+class ScaleInvariantSampler : public Pricer {
+private:
+    std::vector<double> terminal;
+    std::vector<double> average;
+
+public:
+    void GeneratePath(std::span<const double> vec) override {
+        const double s0 = vec.front();
+        terminal.push_back(vec.back() / s0);
+        average.push_back(AsianOptionPricer::PathAverage(vec, m_observations) / s0);
+    }
+
+    void AfterPathCleanUp() override {}
+
+    std::vector<double>& TerminalRatios() { return terminal; }
+    std::vector<double>& AverageRatios() { return average; }
+};
+
+// True if drift and diffusion are homogeneous of degree one in S (GBM and
+// any other SDE whose paths scale with S_0), checked on a few sample points
+inline bool IsScaleInvariant(const SDEGeneral& sde, double T) {
+    for (double t : {0.0, 0.5 * T, T}) {
+        for (double x : {0.5, 1.0, 3.0}) {
+            for (double lambda : {0.25, 7.0}) {
+                const double d1 = sde.drift(t, lambda * x), d2 = lambda * sde.drift(t, x);
+                const double s1 = sde.diffusion(t, lambda * x), s2 = lambda * sde.diffusion(t, x);
+                const double tol = 1e-12 * (1.0 + std::abs(d2) + std::abs(s2));
+                if (std::abs(d1 - d2) > tol || std::abs(s1 - s2) > tol) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Re-evaluates European/Asian call and put payoffs for any spot and strike on
+// the random numbers of one earlier run. For a scale-invariant SDE the path
+// from S_0' is S_0'/S_0 times the stored one, so only the payoff changes.
+//
+// The samples are sorted once with prefix sums of X and X^2; a price then
+// depends only on the moneyness K/S and costs one binary search, which turns
+// spot and strike ladders into a pass over the ladder rather than the paths.
+class IncrementalRepricer {
+private:
+    struct SortedSamples {
+        std::vector<double> x;       // ascending
+        std::vector<double> sum;     // sum[i]  = x[0] + ... + x[i-1]
+        std::vector<double> sumSq;   // sumSq[i] = x[0]^2 + ... + x[i-1]^2
+
+        explicit SortedSamples(std::vector<double> samples)
+            : x(std::move(samples))
+            , sum(x.size() + 1, 0.0)
+            , sumSq(x.size() + 1, 0.0)
+        {
+            std::sort(x.begin(), x.end());
+            for (size_t i = 0; i < x.size(); ++i) {
+                sum[i + 1] = sum[i] + x[i];
+                sumSq[i + 1] = sumSq[i] + x[i] * x[i];
+            }
+        }
+    };
+
+    SortedSamples terminal;
+    SortedSamples average;
+    double discount;
+
+    static PathStatistics Evaluate(const SortedSamples& s, double spot, double strike, int type) {
+        const size_t n = s.x.size();
+        const double k = strike / spot;
+        const size_t split = static_cast<size_t>(std::upper_bound(s.x.begin(), s.x.end(), k) - s.x.begin());
+
+        // Payoff spot*X - K on [split, n) for calls, K - spot*X on [0, split) for puts
+        size_t lo = split, hi = n;
+        double sign = 1.0;
+        if (type == -1) {
+            lo = 0;
+            hi = split;
+            sign = -1.0;
+        }
+        const double m = static_cast<double>(hi - lo);
+        const double sx = s.sum[hi] - s.sum[lo];
+        const double sxx = s.sumSq[hi] - s.sumSq[lo];
+
+        PathStatistics stats;
+        stats.sum = sign * (spot * sx - strike * m);
+        stats.squaredSum = spot * spot * sxx - 2.0 * spot * strike * sx + strike * strike * m;
+        stats.count = static_cast<std::int64_t>(n);
+        return stats;
+    }
+
+public:
+    IncrementalRepricer(std::vector<double> terminalRatios, std::vector<double> averageRatios,
+                        double discountFactor)
+        : terminal(std::move(terminalRatios))
+        , average(std::move(averageRatios))
+        , discount(discountFactor)
+    {
+        if (terminal.x.empty() || terminal.x.size() != average.x.size()) {
+            throw std::runtime_error("Incremental repricer needs one terminal and one average sample per path");
+        }
+    }
+
+    // Runs the base simulation once; throws if the SDE does not scale with S_0
+    static IncrementalRepricer FromSimulation(const PricingRequest& base, std::shared_ptr<MTEngRandNumGen>& rng) {
+        if (!ValidRequest(base)) {
+            throw std::runtime_error("Invalid base pricing request");
+        }
+        auto sde = MakeSDE(base.option);
+        if (!IsScaleInvariant(*sde, base.option.T)) {
+            throw std::runtime_error("SDE is not scale invariant; incremental repricing needs GBM-type dynamics");
+        }
+        if (base.seed != 0) {
+            rng->Seed(base.seed);
+        }
+        auto fdm = MakeFDM(sde, base.scheme, base.NT);
+        auto sampler = std::make_shared<ScaleInvariantSampler>();
+        std::shared_ptr<Pricer> pricer = sampler;
+        auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, base.NSIM);
+        hub.SetVerbose(false);
+        hub.BeginSimulation();
+
+        return IncrementalRepricer(std::move(sampler->TerminalRatios()), std::move(sampler->AverageRatios()),
+                                   std::exp(-base.option.r * base.option.T));
+    }
+
+    size_t NumPaths() const { return terminal.x.size(); }
+
+    // type: 1 == call, -1 == put
+    PricingResult Reprice(double spot, double strike, int type, PayoffStyle style) const {
+        const PathStatistics stats = Evaluate(style == PayoffStyle::Asian ? average : terminal, spot, strike, type);
+        PricingResult res;
+        const auto [sd, se] = stats.StandardDeviationStats();
+        res.price = stats.Price(discount);
+        res.stdDev = sd;
+        res.stdErr = se;
+        res.paths = stats.count;
+        return res;
+    }
+
+    std::vector<PricingResult> SpotLadder(const std::vector<double>& spots, double strike,
+                                          int type, PayoffStyle style) const {
+        std::vector<PricingResult> out;
+        out.reserve(spots.size());
+        for (double s : spots) {
+            out.push_back(Reprice(s, strike, type, style));
+        }
+        return out;
+    }
+
+    std::vector<PricingResult> StrikeLadder(double spot, const std::vector<double>& strikes,
+                                            int type, PayoffStyle style) const {
+        std::vector<PricingResult> out;
+        out.reserve(strikes.size());
+        for (double k : strikes) {
+            out.push_back(Reprice(spot, k, type, style));
+        }
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef JobScheduler_HPP
+#define JobScheduler_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MTEngRandNumGen.hpp"
+#include "NumaTopology.hpp"
+#include "PDESolver.hpp"
+#include "PathStatistics.hpp"
+#include "PerfCounters.hpp"
+#include "Precision.hpp"
+#include "PricingProtocol.hpp"
+#include "SimulationControl.hpp"
+
+struct JobResult {
+    std::uint64_t jobId{0};
+    PricingResult result;
+    PathStatistics stats;     // undiscounted payoff accumulators over all blocks
+    double seconds{0.0};      // submit to completion
+};
+
+using JobCallback = std::function<void(const JobResult&)>;
+
+// Prices many MCCentralHub jobs concurrently on a work-stealing thread pool.
+//
+// Each job is split into blocks of pathsPerBlock paths; block b simulates on
+// substream b of the job seed, so a job's result does not depend on the
+// number of workers or on which worker ran which block. A task is a range of
+// blocks: a worker splits it, keeps the front half and leaves the back half
+// on its deque for idle workers to steal. Workers look at newly submitted
+// jobs before their own deque, so a small job starts after at most one block
+// of whatever is running rather than queuing behind a large job.
+//
+// Every worker allocates its own deque and RNG after it starts (and after it
+// is pinned, if pinWorkers is set), and each block's pricer and path buffers
+// are created on the worker running it, so first-touch places that memory on
+// the worker's NUMA node.
+class JobScheduler {
+public:
+    struct Config {
+        unsigned workers{0};                    // 0 = hardware concurrency
+        std::int64_t pathsPerBlock{4096};
+        size_t kernelBlockSize{0};              // MCCentralHub::SetBlockSize per block
+        size_t rngBatch{1};                     // MCCentralHub::SetRngBatch per block
+        Precision precision{Precision::Double};
+        bool pinWorkers{false};                 // pin worker w to SpreadPlacement()[w]
+        std::shared_ptr<PerfProfile> profile{}; // per-phase, per-worker hardware counters
+        bool routePDE{false};                   // solve PDEEligible requests on the grid instead
+        PDEConfig pde{};                        // grid of routed requests
+    };
+
+    explicit JobScheduler(Config config);
+    ~JobScheduler();   // finishes every submitted job, then joins the workers
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    // The callback (if any) runs on a worker thread before the future is ready,
+    // also for rejected requests and for requests routed to the PDE engine.
+    // With a control, blocks report progress to it and the job stops early
+    // (status Cancelled, partial estimate) once it is cancelled or past its
+    // deadline; the target and discount of the control are set here.
+    std::future<JobResult> Submit(const PricingRequest& request, JobCallback callback = {},
+                                  std::shared_ptr<SimulationControl> control = nullptr);
+
+    void WaitIdle();
+    unsigned NumWorkers() const { return cfg.workers; }
+
+    // CPU each worker runs on, -1 if not pinned
+    const std::vector<int>& WorkerCpus() const { return workerCpu; }
+    const NumaTopology& Topology() const { return topology; }
+    std::string PlacementReport() const;
+
+private:
+    struct Job;
+    struct Task {
+        std::shared_ptr<Job> job;
+        std::int64_t first;   // block range [first, last)
+        std::int64_t last;
+    };
+    struct WorkerQueue {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(size_t id);
+    bool NextTask(size_t id, Task& task);
+    void PushLocal(size_t id, Task task);
+    void RunBlock(size_t id, Job& job, std::int64_t block);
+    void FinishBlock(const std::shared_ptr<Job>& job);
+    void FinishDirect(const std::shared_ptr<Job>& job);   // rejected or PDE-routed job
+    void Deliver(Job& job, const JobResult& res);         // callback, future, idle count
+
+    Config cfg;
+    NumaTopology topology;
+    std::vector<int> workerCpu;
+    std::latch workersReady;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;         // filled in by each worker
+    std::vector<std::thread> workers;
+    std::vector<std::shared_ptr<MTEngRandNumGen>> workerRng;  // filled in by each worker
+
+    std::mutex injectMtx;
+    std::deque<Task> injected;
+
+    std::mutex sleepMtx;
+    std::condition_variable sleepCv;
+    std::condition_variable idleCv;
+    std::atomic<std::int64_t> queuedTasks{0};
+    std::atomic<std::int64_t> activeJobs{0};
+    std::atomic<std::uint64_t> nextJobId{1};
+    bool stopping{false};
+};
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef JumpDiffusion_HPP
+#define JumpDiffusion_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Compound Poisson jumps on top of a diffusion: S jumps to S e^Y at the
+// times of a Poisson process with intensity lambda, and the drift is
+// compensated by -lambda kappa, kappa = E[e^Y] - 1, so the discounted price
+// stays a martingale.
+//
+//   Merton: Y ~ N(meanLog, volLog^2)
+//   Kou:    Y ~ Exp(upRate) with probability upProbability, else -Exp(downRate)
+//
+// Jumps are not tested for at every step. Each path draws its jump times
+// (exponential gaps) and sizes up front; a step without a jump is a plain
+// diffusion step, so blocks run the batched kernel unchanged and only the
+// few paths with a jump in a step are redone with the jump times merged into
+// the grid (see MCCentralHub).
+
+enum class JumpModel { Merton, Kou };
+
+struct JumpCoefficients {
+    JumpModel model{JumpModel::Merton};
+    double intensity{0.0};       // lambda, jumps per year
+    double meanLog{0.0};         // Merton
+    double volLog{0.0};
+    double upProbability{0.5};   // Kou
+    double upRate{0.0};          // eta_1 > 1 so E[e^Y] is finite
+    double downRate{0.0};        // eta_2 > 0
+
+    static JumpCoefficients Merton(double lambda, double mean, double vol) {
+        JumpCoefficients j;
+        j.model = JumpModel::Merton;
+        j.intensity = lambda;
+        j.meanLog = mean;
+        j.volLog = vol;
+        j.Validate();
+        return j;
+    }
+
+    static JumpCoefficients Kou(double lambda, double p, double eta1, double eta2) {
+        JumpCoefficients j;
+        j.model = JumpModel::Kou;
+        j.intensity = lambda;
+        j.upProbability = p;
+        j.upRate = eta1;
+        j.downRate = eta2;
+        j.Validate();
+        return j;
+    }
+
+    void Validate() const {
+        if (intensity < 0.0) {
+            throw std::runtime_error("Jump intensity must be non-negative");
+        }
+        if (model == JumpModel::Merton && volLog < 0.0) {
+            throw std::runtime_error("Merton jump volatility must be non-negative");
+        }
+        if (model == JumpModel::Kou
+            && (upProbability < 0.0 || upProbability > 1.0 || upRate <= 1.0 || downRate <= 0.0)) {
+            throw std::runtime_error("Kou jumps need 0 <= p <= 1, eta1 > 1 and eta2 > 0");
+        }
+    }
+
+    // kappa = E[e^Y] - 1
+    double Compensator() const {
+        if (model == JumpModel::Merton) {
+            return std::exp(meanLog + 0.5 * volLog * volLog) - 1.0;
+        }
+        return upProbability * upRate / (upRate - 1.0)
+             + (1.0 - upProbability) * downRate / (downRate + 1.0) - 1.0;
+    }
+
+    template <typename Gen>
+    double SampleLogJump(Gen& rng) const {
+        if (model == JumpModel::Merton) {
+            return meanLog + volLog * rng.GenerateRandNum();
+        }
+        const double u = rng.GenerateUniform();
+        const double e = -std::log(rng.GenerateUniform());
+        return u < upProbability ? e / upRate : -e / downRate;
+    }
+};
+
+// One jump of one path: inside step `step`, at fraction `frac` of it
+struct JumpEvent {
+    size_t step;
+    size_t path;
+    double frac;
+    double logJump;
+    double bridge;   // normal splitting the step's Brownian increment at the jump
+};
+
+// Draws the jumps of paths [0, nPaths) on the grid `times` into events,
+// sorted by step, then path, then time. Paths draw one after the other.
+template <typename Gen>
+void SampleJumps(const JumpCoefficients& jumps, const std::vector<double>& times, size_t nPaths,
+                 Gen& rng, std::vector<JumpEvent>& events) {
+    events.clear();
+    if (jumps.intensity <= 0.0) return;
+    const double T = times.back();
+    const size_t steps = times.size() - 1;
+
+    for (size_t k = 0; k < nPaths; ++k) {
+        for (double t = -std::log(rng.GenerateUniform()) / jumps.intensity; t < T;
+             t += -std::log(rng.GenerateUniform()) / jumps.intensity) {
+            const auto upper = std::upper_bound(times.begin(), times.end(), t);
+            const size_t j = std::min(static_cast<size_t>(upper - times.begin()) - 1, steps - 1);
+            const double frac = std::clamp((t - times[j]) / (times[j + 1] - times[j]), 0.0, 1.0);
+            const double y = jumps.SampleLogJump(rng);
+            events.push_back(JumpEvent{j, k, frac, y, rng.GenerateRandNum()});
+        }
+    }
+    std::stable_sort(events.begin(), events.end(), [](const JumpEvent& a, const JumpEvent& b) {
+        return a.step != b.step ? a.step < b.step : a.path < b.path;
+    });
+}
+
+// Steps x across a step of length dt starting at t with whole-step normal z,
+// applying the jumps [first, last) of this path and step at their times.
+// The Brownian increment sqrt(dt) z is split at each jump time by a bridge,
+// so the path keeps the increment it would have had without jumps.
+// step(x, t, h, z) advances x by one scheme step of length h.
+template <typename Step>
+double StepAcrossJumps(double x, double t, double dt, double z,
+                       const JumpEvent* first, const JumpEvent* last, Step&& step) {
+    double rest = std::sqrt(dt) * z;   // Brownian increment still to be spent
+    double left = dt;
+    double elapsed = 0.0;
+    for (const JumpEvent* e = first; e != last; ++e) {
+        const double h = e->frac * dt - elapsed;
+        if (h > 0.0 && h < left) {
+            const double dW = (h / left) * rest + std::sqrt(h * (left - h) / left) * e->bridge;
+            x = step(x, t + elapsed, h, dW / std::sqrt(h));
+            rest -= dW;
+            left -= h;
+            elapsed += h;
+        }
+        else if (h > 0.0 && left > 0.0) {
+            // Jump at the end of the step
+            x = step(x, t + elapsed, left, rest / std::sqrt(left));
+            elapsed += left;
+            left = 0.0;
+        }
+        x *= std::exp(e->logJump);
+    }
+    if (left > 0.0) {
+        x = step(x, t + elapsed, left, rest / std::sqrt(left));
+    }
+    return x;
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef LocalVolSurface_HPP
+#define LocalVolSurface_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Local volatility sigma(t, S) on a (t, S) grid, bilinear in both directions
+// with flat extrapolation. Nodes are stored time-major in one contiguous
+// array, vols[i * NumSpots() + j] = sigma(times[i], spots[j]).
+//
+// Path kernels do not call Vol() per path. Once per step they collapse the
+// surface to the slice at t (SliceAt: a level and a slope per spot cell),
+// then look up every path in that slice with VolBlock, which walks from each
+// path's bracket of the previous step instead of searching from scratch.
+class LocalVolSurface {
+private:
+    std::vector<double> times;
+    std::vector<double> spots;
+    std::vector<double> vols;
+    std::vector<double> invDS;   // 1 / (spots[j + 1] - spots[j]), 0 for the last node
+
+    static void CheckAxis(const std::vector<double>& axis, const char* name) {
+        if (axis.empty()) {
+            throw std::runtime_error(std::string("Local vol surface needs at least one ") + name);
+        }
+        for (size_t i = 1; i < axis.size(); ++i) {
+            if (!(axis[i] > axis[i - 1])) {
+                throw std::runtime_error(std::string("Local vol ") + name + " must be strictly increasing");
+            }
+        }
+    }
+
+    // Index i and weight w with value = (1 - w) * v[i] + w * v[i + 1]; w = 0 past either end
+    static size_t Bracket(const std::vector<double>& axis, double x, double& w) {
+        w = 0.0;
+        if (x <= axis.front()) return 0;
+        if (x >= axis.back()) return axis.size() - 1;
+        const size_t i = static_cast<size_t>(std::upper_bound(axis.begin(), axis.end(), x) - axis.begin()) - 1;
+        w = (x - axis[i]) / (axis[i + 1] - axis[i]);
+        return i;
+    }
+
+public:
+    LocalVolSurface(std::vector<double> timeNodes, std::vector<double> spotNodes, std::vector<double> volNodes)
+        : times(std::move(timeNodes))
+        , spots(std::move(spotNodes))
+        , vols(std::move(volNodes))
+    {
+        CheckAxis(times, "time");
+        CheckAxis(spots, "spot");
+        if (vols.size() != times.size() * spots.size()) {
+            throw std::runtime_error("Local vol surface needs one vol per (time, spot) node");
+        }
+        for (double v : vols) {
+            if (!(v >= 0.0)) {
+                throw std::runtime_error("Local vols must be non-negative");
+            }
+        }
+        invDS.assign(spots.size(), 0.0);
+        for (size_t j = 0; j + 1 < spots.size(); ++j) {
+            invDS[j] = 1.0 / (spots[j + 1] - spots[j]);
+        }
+    }
+
+    // Samples sigma(t, S) on the grid
+    static LocalVolSurface FromFunction(std::vector<double> timeNodes, std::vector<double> spotNodes,
+                                        const std::function<double(double, double)>& sigma) {
+        std::vector<double> v;
+        v.reserve(timeNodes.size() * spotNodes.size());
+        for (double t : timeNodes) {
+            for (double s : spotNodes) {
+                v.push_back(sigma(t, s));
+            }
+        }
+        return LocalVolSurface(std::move(timeNodes), std::move(spotNodes), std::move(v));
+    }
+
+    const std::vector<double>& Times() const { return times; }
+    const std::vector<double>& Spots() const { return spots; }
+    size_t NumSpots() const { return spots.size(); }
+
+    // Bilinear lookup; dVolDS (if given) receives the slope in S of the cell
+    double Vol(double t, double S, double* dVolDS = nullptr) const {
+        double wt, ws;
+        const size_t i = Bracket(times, t, wt);
+        const size_t j = Bracket(spots, S, ws);
+        const size_t nS = spots.size();
+        const size_t i1 = std::min(i + 1, times.size() - 1);
+        const size_t j1 = std::min(j + 1, nS - 1);
+        const double lo = (1.0 - ws) * vols[i * nS + j] + ws * vols[i * nS + j1];
+        const double hi = (1.0 - ws) * vols[i1 * nS + j] + ws * vols[i1 * nS + j1];
+        if (dVolDS) {
+            const bool inside = S > spots.front() && S < spots.back();
+            const double dLo = (vols[i * nS + j1] - vols[i * nS + j]) * invDS[j];
+            const double dHi = (vols[i1 * nS + j1] - vols[i1 * nS + j]) * invDS[j];
+            *dVolDS = inside ? (1.0 - wt) * dLo + wt * dHi : 0.0;
+        }
+        return (1.0 - wt) * lo + wt * hi;
+    }
+
+    // The surface at time t as linear pieces in S:
+    // vol(S) = level[j] + slope[j] * (S - spots[j]) on [spots[j], spots[j + 1])
+    void SliceAt(double t, std::vector<double>& level, std::vector<double>& slope) const {
+        const size_t nS = spots.size();
+        double wt;
+        const size_t i = Bracket(times, t, wt);
+        const size_t i1 = std::min(i + 1, times.size() - 1);
+        level.resize(nS);
+        slope.resize(nS);
+        const double* lo = &vols[i * nS];
+        const double* hi = &vols[i1 * nS];
+        for (size_t j = 0; j < nS; ++j) {
+            level[j] = (1.0 - wt) * lo[j] + wt * hi[j];
+        }
+        for (size_t j = 0; j + 1 < nS; ++j) {
+            slope[j] = (level[j + 1] - level[j]) * invDS[j];
+        }
+        slope[nS - 1] = 0.0;
+    }
+
+    // Vols of n states in a slice. hints[k] is path k's spot cell from the
+    // previous lookup and is updated; paths move a cell or two per step, so the
+    // walk is usually zero or one comparison. Any hint value is safe.
+    template <typename Real>
+    void VolBlock(const double* level, const double* slope, const Real* S, size_t n,
+                  std::uint32_t* hints, Real* out) const {
+        const double* nodes = spots.data();
+        const size_t last = spots.size() - 1;
+        const double lo = nodes[0];
+        const double hi = nodes[last];
+        for (size_t k = 0; k < n; ++k) {
+            const double s = std::clamp(static_cast<double>(S[k]), lo, hi);
+            size_t j = std::min<size_t>(hints[k], last);
+            while (j < last && s >= nodes[j + 1]) ++j;
+            while (j > 0 && s < nodes[j]) --j;
+            hints[k] = static_cast<std::uint32_t>(j);
+            out[k] = static_cast<Real>(level[j] + slope[j] * (s - nodes[j]));
+        }
+    }
+};
+
+#endif
@@ -1,12 +1,27 @@
 #ifndef CentralHub_HPP
 #define CentralHub_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <vector>
+#include <tuple>
+#include <iostream>
+#include <stdexcept>
 #include "SDEGeneral.hpp"
 #include "Pricer.hpp"
 #include "FDMType.hpp"
+#include "JumpDiffusion.hpp"
 #include "MTEngRandNumGen.hpp"
+#include "PathStore.hpp"
+#include "PerfCounters.hpp"
+#include "Precision.hpp"
+#include "RngPipeline.hpp"
+#include "SimulationControl.hpp"
+#include "StratifiedSampling.hpp"
+#include "StreamingPricer.hpp"
 
 template<typename SDEGeneral, typename Pricer, typename FDMType, typename MTEngRandNumGen>
 class MCCentralHub {
@@ -15,57 +30,600 @@ private:
     std::shared_ptr<Pricer> pricer;
     std::shared_ptr<FDMType> fdm;
     std::shared_ptr<MTEngRandNumGen> randGen;
-    int NumSim;
+    std::int64_t NumSim;
     int PathSize;
     std::vector<double> path;
+    bool verbose{true};
+    std::shared_ptr<PathStoreWriter> pathWriter;
+    Precision precision{Precision::Double};
+    size_t blockSize{0};
+    size_t rngBatch{1};
+    std::optional<RngPipelineConfig> rngPipeline;
+    RngPipelineStats pipelineStats;
+    std::shared_ptr<SimulationControl> control;
+    PathStatistics published;     // pricer accumulators already reported to control
+    std::int64_t simulated{0};
+    std::optional<StratificationConfig> stratification;
+    StratifiedEstimate stratified;
+    double driftShift{0.0};
+    bool collectShiftMoments{false};
+    std::vector<double> sqrtDts;
+    std::shared_ptr<PerfProfile> profile;
+    StreamingPricer* streaming{nullptr};   // set when block mode may skip path storage
+    std::vector<JumpEvent> jumpEvents;     // jumps of the current path or block
+
+    // Block mode storage, kept across runs so a reused hub does not reallocate
+    template <typename Real>
+    struct BlockBuffers {
+        std::vector<Real> states;
+        std::vector<Real> normals;
+    };
+    BlockBuffers<double> doubleBlocks;
+    BlockBuffers<float> singleBlocks;
+    std::vector<double> blockW;            // W_T of each path of the block
+    std::vector<double> jumpFrom;          // step start values of jumping paths
+
+public:
+    // Cross-entropy moments (see CollectShiftMoments): sums over paths of the
+    // weighted payoff f L and of f L W_T (W_T under the sampling measure)
+    struct ShiftMoments {
+        double weightedPayoff{0.0};
+        double weightedPayoffW{0.0};
+    };
+
+private:
+    ShiftMoments shiftMoments;
+
+    static constexpr size_t DefaultBlockSize = 256;
+    static constexpr int ControlInterval = 1024;   // paths between checks in path-by-path mode
 
 public:
+    // numTime must be the scheme's step count: paths are stepped through its
+    // per-step dt, so a longer path would read past the end of the grid
     MCCentralHub(const std::tuple<std::shared_ptr<SDEGeneral>, std::shared_ptr<Pricer>, 
                  std::shared_ptr<FDMType>, std::shared_ptr<MTEngRandNumGen>>& pieces, 
-                 int numSimulations, int numTime) 
+                 std::int64_t numSimulations, int numTime) 
         : sde(std::get<0>(pieces))
         , pricer(std::get<1>(pieces))
         , fdm(std::get<2>(pieces))
         , randGen(std::get<3>(pieces))
         , NumSim(numSimulations)
         , PathSize(numTime + 1)
-        , path(static_cast<size_t>(PathSize))
+    {
+        if (numTime != fdm->getNumTimeSteps()) {
+            throw std::runtime_error("Hub time steps do not match the scheme's time grid");
+        }
+        path.resize(static_cast<size_t>(PathSize));
+    }
+
+    // Path length taken from the scheme's time grid (needed for non-uniform grids)
+    MCCentralHub(const std::tuple<std::shared_ptr<SDEGeneral>, std::shared_ptr<Pricer>, 
+                 std::shared_ptr<FDMType>, std::shared_ptr<MTEngRandNumGen>>& pieces, 
+                 std::int64_t numSimulations) 
+        : MCCentralHub(pieces, numSimulations, std::get<2>(pieces)->getNumTimeSteps())
     {}
 
+    // Re-targets the hub at numSimulations paths on the scheme's current grid,
+    // for pieces reconfigured in place (FDMType::setUniformGrid,
+    // Pricer::ResetStatistics). Path and block buffers keep their capacity,
+    // so reruns on grids no larger than before do not allocate.
+    void Reuse(std::int64_t numSimulations) {
+        const int size = fdm->getNumTimeSteps() + 1;
+        if (pathWriter && pathWriter->Info().times.size() != static_cast<size_t>(size)) {
+            throw std::runtime_error("Path store grid does not match the simulation grid");
+        }
+        NumSim = numSimulations;
+        PathSize = size;
+        path.resize(static_cast<size_t>(PathSize));
+    }
+
+    // Prints the first time points before simulating; progress goes through
+    // the SimulationControl instead
+    void SetVerbose(bool on) { verbose = on; }
+
+    // Progress is published and cancellation/deadline checked at every block
+    // boundary (every ControlInterval paths in path-by-path mode). A stopped
+    // run leaves the pricer with the paths finished so far.
+    void AttachControl(std::shared_ptr<SimulationControl> ctl) { control = std::move(ctl); }
+
+    std::int64_t PathsSimulated() const { return simulated; }
+    bool Stopped() const { return simulated < NumSim; }
+
+    // Hardware counters per phase: "rng", "step" and "price" in block mode,
+    // a single "simulate" phase otherwise. Block mode keeps its SetRngBatch
+    // batching; each batch's draw is counted as "rng" and the stepping
+    // around it as "step", so the working set matches unprofiled runs.
+    void AttachProfile(std::shared_ptr<PerfProfile> p) { profile = std::move(p); }
+
+    // Every simulated path is also appended to the store
+    void AttachPathWriter(std::shared_ptr<PathStoreWriter> writer) {
+        if (writer && writer->Info().times.size() != static_cast<size_t>(PathSize)) {
+            throw std::runtime_error("Path store grid does not match the simulation grid");
+        }
+        pathWriter = std::move(writer);
+    }
+
+    // Block mode steps blockSize paths at a time through the scheme's batched
+    // kernel (0 = classic path-by-path loop). Single precision keeps path
+    // state and normals in float32 and implies block mode; pricers still
+    // receive double paths and accumulate in double.
+    void SetBlockSize(size_t paths) { blockSize = paths; }
+
+    // Block mode draws the normals of rngBatch steps at a time (same order,
+    // so results do not change); larger batches run the generator in longer
+    // bursts at the cost of a B x rngBatch buffer
+    void SetRngBatch(size_t steps) { rngBatch = std::max<size_t>(1, steps); }
+
+    // Pipelined block mode: a producer thread owns the generator for the run
+    // and draws the normals, in the order block mode would, into the chunks
+    // of a ring that the stepping thread consumes in place. Prices match the
+    // inline run; only a stopped run leaves the generator further advanced.
+    // Implies block mode; jump and stratified runs draw inline and reject it.
+    void SetRngPipeline(std::optional<RngPipelineConfig> config) { rngPipeline = config; }
+    const RngPipelineStats& PipelineStats() const { return pipelineStats; }
+    void SetPrecision(Precision p) { precision = p; }
+
+    // Sampling strategy: plain Monte Carlo (nullopt, the default) or
+    // stratified W_T with Brownian-bridge paths, stepped in double blocks
+    // (Precision::Single is rejected). The strata are capped at NumSim / 2.
+    // The pricer still sees every path; under optimal allocation its pooled
+    // mean is biased, so take the price and SE from Stratified().
+    void SetStratification(std::optional<StratificationConfig> config) { stratification = config; }
+    const StratifiedEstimate& Stratified() const { return stratified; }
+
+    // Importance sampling: Brownian increments get drift theta (dW + theta dt)
+    // and each payoff is weighted by the likelihood ratio
+    // exp(-theta W_T + theta^2 T / 2), so pricer estimates stay unbiased.
+    // Works with any scheme since only the normals change; see
+    // ImportanceSampling.hpp for choosing theta. 0 turns it off.
+    void SetDriftShift(double theta) { driftShift = theta; }
+
+    // Accumulates DriftShiftMoments from each path's payoff (Pricer::LastPayoff)
+    // and likelihood ratio, also at theta = 0 where the ratio is 1
+    void CollectShiftMoments(bool on) { collectShiftMoments = on; }
+    const ShiftMoments& DriftShiftMoments() const { return shiftMoments; }
+
     void BeginSimulation() {
-        const double S_0 = sde->data->S_0;
-        const double dt = fdm->getTimeStep();
+        pricer->SetObservationIndices(fdm->getObservationIndices());
+        simulated = 0;
+        published = pricer->Statistics();
+        shiftMoments = ShiftMoments{};
+        if (Shifted() && stratification) {
+            throw std::runtime_error("Drift shift and stratified sampling cannot be combined");
+        }
+        if (sde->jumps && stratification) {
+            throw std::runtime_error("Jump diffusions cannot be stratified");
+        }
+        if (rngPipeline && (sde->jumps || stratification)) {
+            throw std::runtime_error("Jump and stratified runs cannot use the RNG pipeline");
+        }
+        if (stratification && precision == Precision::Single) {
+            throw std::runtime_error("Stratified runs are simulated in double precision only");
+        }
+        if (stratification && NumSim < 2) {
+            throw std::runtime_error("Stratified runs need at least two paths");
+        }
+        // Streaming pricers take each step's states directly; the full paths
+        // are still built when they are written out or need a shift weight
+        streaming = nullptr;
+        if constexpr (std::is_base_of_v<Pricer, StreamingPricer>) {
+            if (!pathWriter && !Shifted()) {
+                streaming = dynamic_cast<StreamingPricer*>(pricer.get());
+            }
+        }
+        jumpEvents.clear();
+        sqrtDts.clear();
+        for (double dt : fdm->getTimeSteps()) {
+            sqrtDts.push_back(std::sqrt(dt));
+        }
         
         // Print first few time points
-        const auto& timePoints = fdm->getTimePoints();
-        std::cout << "First few time points: ";
-        for (size_t i = 0; i < std::min(static_cast<size_t>(5), timePoints.size()); ++i) {
-            std::cout << timePoints[i] << " ";
+        if (verbose) {
+            const auto& timePoints = fdm->getTimePoints();
+            std::cout << "First few time points: ";
+            for (size_t i = 0; i < std::min(static_cast<size_t>(5), timePoints.size()); ++i) {
+                std::cout << timePoints[i] << " ";
+            }
+            std::cout << '\n';
+        }
+
+        if (stratification) {
+            ScopedPerfPhase phase(profile.get(), "simulate", 0, 0);
+            SimulateStratified();
+            phase.SetWork(simulated, simulated * (PathSize - 1));
+        }
+        else if (precision == Precision::Single) {
+            SimulateBlocks<float>();
+        }
+        else if (blockSize > 0 || rngPipeline) {
+            SimulateBlocks<double>();
+        }
+        else {
+            ScopedPerfPhase phase(profile.get(), "simulate", 0, 0);
+            SimulatePathByPath();
+            phase.SetWork(simulated, simulated * (PathSize - 1));
+        }
+
+        if (Shifted()) {
+            pricer->SetPathWeight(1.0);
+        }
+        pricer->AfterPathCleanUp();
+    }
+
+private:
+    // Paths need W_T and a likelihood ratio
+    bool Shifted() const { return driftShift != 0.0 || collectShiftMoments; }
+
+    double LikelihoodRatio(double W) const {
+        const double T = fdm->getTimePoints().back() - fdm->getTimePoints().front();
+        return std::exp(-driftShift * W + 0.5 * driftShift * driftShift * T);
+    }
+
+    // Prices one path, weighted by its likelihood ratio when shifted
+    void PricePath(double W) {
+        if (!Shifted()) {
+            pricer->GeneratePath(path);
+            return;
+        }
+        const double L = LikelihoodRatio(W);
+        pricer->SetPathWeight(L);
+        pricer->GeneratePath(path);
+        if (collectShiftMoments) {
+            const double fL = pricer->LastPayoff() * L;
+            shiftMoments.weightedPayoff += fL;
+            shiftMoments.weightedPayoffW += fL * W;
         }
-        std::cout << std::endl;
+    }
+
+    bool ShouldStop() const { return control && control->ShouldStop(); }
+
+    // Redoes step j of the path that starts it at x across its jumps
+    // [first, last); z is the whole step's (shifted) normal
+    double JumpStep(double x, size_t j, double z, const JumpEvent* first, const JumpEvent* last) {
+        return StepAcrossJumps(x, fdm->getTimePoint(j), fdm->getTimeStep(j), z, first, last,
+                               [this](double s, double t, double h, double zh) {
+                                   return fdm->next_n(s, t, h, zh, 0.0);
+                               });
+    }
+
+    // Events of step j for the path of *first, starting at first
+    const JumpEvent* PathJumpsEnd(const JumpEvent* first) const {
+        const JumpEvent* last = first;
+        const JumpEvent* end = jumpEvents.data() + jumpEvents.size();
+        while (last != end && last->step == first->step && last->path == first->path) ++last;
+        return last;
+    }
+
+    // Publishes the paths and pricer accumulators added since the last call
+    void Checkpoint(std::int64_t newPaths) {
+        simulated += newPaths;
+        if (!control) return;
+
+        const PathStatistics now = pricer->Statistics();
+        control->Record(newPaths, PathStatistics{now.sum - published.sum,
+                                                 now.squaredSum - published.squaredSum,
+                                                 now.count - published.count});
+        published = now;
+    }
+
+    void SimulatePathByPath() {
+        const double S_0 = sde->data->S_0;
 
-        for (int i = 0; i < NumSim; ++i) {
-            if (i % 5000 == 0) {
-                std::cout << "Processing simulation " << i << std::endl;
+        std::int64_t sinceCheck = 0;
+        for (std::int64_t i = 0; i < NumSim; ++i) {
+            if (i % ControlInterval == 0) {
+                Checkpoint(sinceCheck);
+                sinceCheck = 0;
+                if (ShouldStop()) return;
             }
-            
+
             path[0] = S_0;
             double VOld = S_0;
+            double W = 0.0;
+            if (sde->jumps) {
+                SampleJumps(*sde->jumps, fdm->getTimePoints(), 1, *randGen, jumpEvents);
+            }
+            size_t nextJump = 0;
             
             for (int j = 1; j < PathSize; ++j) {
                 const double t = fdm->getTimePoint(static_cast<size_t>(j - 1));
-                const double normVar = randGen->GenerateRandNum();
+                const double dt = fdm->getTimeStep(static_cast<size_t>(j - 1));
+                double normVar = randGen->GenerateRandNum();
                 const double normVar2 = randGen->GenerateRandNum();
+                if (Shifted()) {
+                    const double sqdt = sqrtDts[static_cast<size_t>(j - 1)];
+                    normVar += driftShift * sqdt;
+                    W += sqdt * normVar;
+                }
                 
-                const double VNew = fdm->next_n(VOld, t, dt, normVar, normVar2);
+                double VNew;
+                if (nextJump < jumpEvents.size() && jumpEvents[nextJump].step == static_cast<size_t>(j - 1)) {
+                    const JumpEvent* first = &jumpEvents[nextJump];
+                    const JumpEvent* last = PathJumpsEnd(first);
+                    VNew = JumpStep(VOld, static_cast<size_t>(j - 1), normVar, first, last);
+                    nextJump += static_cast<size_t>(last - first);
+                }
+                else {
+                    VNew = fdm->next_n(VOld, t, dt, normVar, normVar2);
+                }
                 path[static_cast<size_t>(j)] = VNew;
                 VOld = VNew;
             }
             
-            pricer->GeneratePath(path);
+            PricePath(W);
+            if (pathWriter) {
+                pathWriter->Append(path);
+            }
+            ++sinceCheck;
         }
-        
-        pricer->AfterPathCleanUp();
+        Checkpoint(sinceCheck);
+    }
+
+    template <typename Real>
+    BlockBuffers<Real>& Buffers() {
+        if constexpr (std::is_same_v<Real, float>) {
+            return singleBlocks;
+        }
+        else {
+            return doubleBlocks;
+        }
+    }
+
+    template <typename Real>
+    Real DrawNormal() {
+        if constexpr (std::is_same_v<Real, float> && requires { randGen->GenerateRandNumSingle(); }) {
+            return randGen->GenerateRandNumSingle();
+        }
+        else {
+            return static_cast<Real>(randGen->GenerateRandNum());
+        }
+    }
+
+    // Paths of a block are stored step-major (states[j * B + k]) so each step
+    // is one contiguous kernel call; one normal is drawn per path and step.
+    // A streaming pricer sees each step's states as they are produced, so only
+    // the current step is kept. Jumps are drawn for the whole block first;
+    // the kernel steps every path and the few with a jump in the step are
+    // then redone from their start value across the jump times.
+    template <typename Real>
+    void SimulateBlocks() {
+        const size_t B = blockSize > 0 ? blockSize : DefaultBlockSize;
+        const size_t P = static_cast<size_t>(PathSize);
+        const auto total = static_cast<size_t>(NumSim);
+        const Real S_0 = static_cast<Real>(sde->data->S_0);
+
+        auto& states = Buffers<Real>().states;
+        states.resize(streaming ? B : B * P);
+        const size_t batch = std::min(rngBatch, P - 1);
+        auto& normals = Buffers<Real>().normals;
+        normals.resize(rngPipeline ? 0 : B * batch);
+
+        // Pipelined: each step's normals are one B-long segment of a ring chunk
+        std::optional<SpscChunkRing<Real>> ring;
+        std::optional<RingProducer<Real>> producer;
+        size_t stepsPerChunk = 0;
+        Real* chunk = nullptr;
+        size_t segment = 0;
+        pipelineStats = RngPipelineStats{};
+        if (rngPipeline) {
+            stepsPerChunk = std::clamp<size_t>(rngPipeline->chunkBytes / (B * sizeof(Real)), 1, std::max<size_t>(P - 1, 1));
+            segment = stepsPerChunk;
+            ring.emplace(rngPipeline->slots, stepsPerChunk * B);
+            producer.emplace(*ring, rngPipeline->producerCpu, [this, B, stepsPerChunk](SpscChunkRing<Real>& out) {
+                ProduceNormals<Real>(out, B, stepsPerChunk);
+            });
+        }
+        auto nextSegment = [&] {
+            if (segment == stepsPerChunk) {
+                if (chunk) ring->ReleaseRead();
+                chunk = ring->AcquireRead();
+                if (!chunk) {
+                    throw std::runtime_error("RNG pipeline closed early");
+                }
+                ++pipelineStats.chunks;
+                segment = 0;
+            }
+            return chunk + B * segment++;
+        };
+        auto& W = blockW;
+        W.resize(B);
+        jumpFrom.resize(sde->jumps ? B : 0);
+
+        for (size_t first = 0; first < total; first += B) {
+            if (ShouldStop()) return;
+            const size_t n = std::min(B, total - first);
+            const auto blockPaths = static_cast<std::int64_t>(n);
+            const auto blockSteps = static_cast<std::int64_t>(n * (P - 1));
+
+            if (sde->jumps) {
+                ScopedPerfPhase phase(profile.get(), "jumps", blockPaths, blockSteps);
+                SampleJumps(*sde->jumps, fdm->getTimePoints(), n, *randGen, jumpEvents);
+            }
+            size_t nextJump = 0;
+
+            {
+                // Profiled: the "step" segment is closed before and restarted
+                // after every batch draw, which is counted as "rng"
+                PerfSample stepStart;
+                if (profile) stepStart = ThreadPerfCounters().Read();
+                std::fill(states.begin(), states.begin() + static_cast<std::ptrdiff_t>(n), S_0);
+                std::fill(W.begin(), W.end(), 0.0);
+                if (streaming) {
+                    streaming->BeginBlock(P, n);
+                    streaming->Observe(0, states.data(), n);
+                }
+                for (size_t j = 1; j < P; ++j) {
+                    Real* z = rngPipeline ? nextSegment() : &normals[((j - 1) % batch) * B];
+                    if (!rngPipeline && (j - 1) % batch == 0) {
+                        const size_t batchEnd = std::min(j + batch, P);
+                        if (profile) profile->Record("step", ThreadPerfCounters().Read() - stepStart, 0, 0);
+                        {
+                            ScopedPerfPhase phase(profile.get(), "rng", j == 1 ? blockPaths : 0,
+                                                  static_cast<std::int64_t>(n * (batchEnd - j)));
+                            for (size_t i = j; i < batchEnd; ++i) {
+                                Real* zi = &normals[(i - j) * B];
+                                for (size_t k = 0; k < n; ++k) {
+                                    zi[k] = DrawNormal<Real>();
+                                }
+                            }
+                        }
+                        if (profile) stepStart = ThreadPerfCounters().Read();
+                    }
+                    if (Shifted()) {
+                        const double sqdt = sqrtDts[j - 1];
+                        const Real shift = static_cast<Real>(driftShift * sqdt);
+                        for (size_t k = 0; k < n; ++k) {
+                            z[k] += shift;
+                            W[k] += sqdt * static_cast<double>(z[k]);
+                        }
+                    }
+                    Real* cur = states.data();
+                    if (!streaming) {
+                        const Real* prev = &states[(j - 1) * B];
+                        cur = &states[j * B];
+                        std::copy(prev, prev + n, cur);
+                    }
+                    const size_t jumpsBegin = nextJump;
+                    while (nextJump < jumpEvents.size() && jumpEvents[nextJump].step == j - 1) {
+                        jumpFrom[jumpEvents[nextJump].path] = static_cast<double>(cur[jumpEvents[nextJump].path]);
+                        ++nextJump;
+                    }
+                    fdm->next_block(cur, z, n, fdm->getTimePoint(j - 1), fdm->getTimeStep(j - 1));
+                    for (size_t e = jumpsBegin; e < nextJump;) {
+                        const JumpEvent* from = &jumpEvents[e];
+                        const JumpEvent* to = PathJumpsEnd(from);
+                        const size_t k = from->path;
+                        cur[k] = static_cast<Real>(JumpStep(jumpFrom[k], j - 1, static_cast<double>(z[k]), from, to));
+                        e += static_cast<size_t>(to - from);
+                    }
+                    if (streaming) {
+                        streaming->Observe(j, cur, n);
+                    }
+                }
+                if (profile) profile->Record("step", ThreadPerfCounters().Read() - stepStart, blockPaths, blockSteps);
+            }
+
+            {
+                ScopedPerfPhase phase(profile.get(), "price", blockPaths, blockSteps);
+                if (streaming) {
+                    streaming->EndBlock(n);
+                }
+                for (size_t k = 0; k < n && !streaming; ++k) {
+                    for (size_t j = 0; j < P; ++j) {
+                        path[j] = static_cast<double>(states[j * B + k]);
+                    }
+                    PricePath(W[k]);
+                    if (pathWriter) {
+                        pathWriter->Append(path);
+                    }
+                }
+            }
+            Checkpoint(blockPaths);
+        }
+        if (ring) {
+            pipelineStats.producerStalls = ring->ProducerStalls();
+            pipelineStats.consumerStalls = ring->ConsumerStalls();
+        }
+    }
+
+    // Producer side of the pipeline: the normals of every block and step in
+    // SimulateBlocks order, n of each B-long segment used; returns early
+    // once the ring is closed
+    template <typename Real>
+    void ProduceNormals(SpscChunkRing<Real>& ring, size_t B, size_t stepsPerChunk) {
+        const size_t P = static_cast<size_t>(PathSize);
+        const auto total = static_cast<size_t>(NumSim);
+        Real* chunk = nullptr;
+        size_t segment = stepsPerChunk;
+        for (size_t first = 0; first < total; first += B) {
+            const size_t n = std::min(B, total - first);
+            for (size_t j = 1; j < P; ++j) {
+                if (segment == stepsPerChunk) {
+                    if (chunk) ring.CommitWrite();
+                    chunk = ring.AcquireWrite();
+                    if (!chunk) return;
+                    segment = 0;
+                }
+                Real* z = chunk + B * segment++;
+                for (size_t k = 0; k < n; ++k) {
+                    z[k] = DrawNormal<Real>();
+                }
+            }
+        }
+        if (chunk) ring.CommitWrite();
+    }
+
+    void SimulateStratified() {
+        const StratificationConfig& cfg = *stratification;
+        const std::int64_t total = NumSim;
+        // At most NumSim / 2 strata, so each gets the two paths its SE needs
+        const size_t M = std::clamp<size_t>(cfg.strata, 1, static_cast<size_t>(NumSim / 2));
+        stratified.strata.assign(M, PathStatistics{});
+        const std::vector<double> even(M, 1.0);
+
+        const auto pilotPaths = static_cast<std::int64_t>(cfg.pilotFraction * static_cast<double>(total));
+        const std::int64_t pilot = std::min(total, std::max(pilotPaths, 2 * static_cast<std::int64_t>(M)));
+        if (cfg.allocation == StrataAllocation::Proportional || pilot == total) {
+            SimulateStrata(AllocatePaths(total, even, 0));
+            return;
+        }
+
+        // Pilot run estimates the stratum SDs, the rest tops each stratum up
+        // to its Neyman share of the total
+        const std::vector<std::int64_t> pilotCounts = AllocatePaths(pilot, even, 0);
+        if (!SimulateStrata(pilotCounts)) return;
+        std::vector<double> sds(M);
+        for (size_t i = 0; i < M; ++i) {
+            sds[i] = std::get<0>(stratified.strata[i].StandardDeviationStats());
+        }
+        SimulateStrata(NeymanTopUp(total, pilotCounts, sds));
+    }
+
+    // Runs counts[i] paths in stratum i; false if stopped by the control
+    bool SimulateStrata(const std::vector<std::int64_t>& counts) {
+        const size_t B = blockSize > 0 ? blockSize : DefaultBlockSize;
+        const size_t P = static_cast<size_t>(PathSize);
+        const size_t M = counts.size();
+        const auto& times = fdm->getTimePoints();
+        const double sqrtT = std::sqrt(times.back() - times.front());
+        const double S_0 = sde->data->S_0;
+        auto normal = [this] { return randGen->GenerateRandNum(); };
+
+        std::vector<double> states(B * P);
+        std::vector<double> normals(B * P);
+
+        for (size_t i = 0; i < M; ++i) {
+            for (auto left = static_cast<size_t>(counts[i]); left > 0;) {
+                if (ShouldStop()) return false;
+                const size_t n = std::min(B, left);
+
+                for (size_t k = 0; k < n; ++k) {
+                    const double u = (static_cast<double>(i) + randGen->GenerateUniform()) / static_cast<double>(M);
+                    BrownianBridgeNormals(times, sqrtT * InverseNormalCDF(u), normal, &normals[k], B);
+                }
+                std::fill(states.begin(), states.begin() + static_cast<std::ptrdiff_t>(n), S_0);
+                for (size_t j = 1; j < P; ++j) {
+                    const double* prev = &states[(j - 1) * B];
+                    double* cur = &states[j * B];
+                    std::copy(prev, prev + n, cur);
+                    fdm->next_block(cur, &normals[(j - 1) * B], n, fdm->getTimePoint(j - 1), fdm->getTimeStep(j - 1));
+                }
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t j = 0; j < P; ++j) {
+                        path[j] = states[j * B + k];
+                    }
+                    pricer->GeneratePath(path);
+                    stratified.strata[i].Add(pricer->LastPayoff());
+                    if (pathWriter) {
+                        pathWriter->Append(path);
+                    }
+                }
+
+                Checkpoint(static_cast<std::int64_t>(n));
+                left -= n;
+            }
+        }
+        return true;
     }
 };
 
@@ -2,21 +2,111 @@
 #define MTEngRandNumGen_HPP
 
 #include <random>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// std::seed_seq over a fixed number of seed words, without its heap-held
+// copy: generate() is the standard's algorithm, so engines seeded from it
+// get exactly the state std::seed_seq would give them
+template <std::size_t N>
+class FixedSeedSeq {
+private:
+    std::array<std::uint32_t, N> v;
+
+public:
+    using result_type = std::uint32_t;
+
+    explicit FixedSeedSeq(const std::array<std::uint32_t, N>& words) : v(words) {}
+
+    std::size_t size() const { return N; }
+
+    template <typename It>
+    void generate(It begin, It end) const {
+        const auto n = static_cast<std::size_t>(end - begin);
+        if (n == 0) return;
+        auto at = [begin](std::size_t i) -> auto& { return begin[static_cast<std::ptrdiff_t>(i)]; };
+        auto mix = [](std::uint32_t x) { return x ^ (x >> 27); };
+        for (std::size_t i = 0; i < n; ++i) at(i) = 0x8b8b8b8bu;
+
+        const std::size_t t = n >= 623 ? 11 : n >= 68 ? 7 : n >= 39 ? 5 : n >= 7 ? 3 : (n - 1) / 2;
+        const std::size_t p = (n - t) / 2;
+        const std::size_t q = p + t;
+        const std::size_t m = std::max(N + 1, n);
+        for (std::size_t k = 0; k < m; ++k) {
+            const std::uint32_t r1 = 1664525u * mix(static_cast<std::uint32_t>(at(k % n) ^ at((k + p) % n) ^ at((k + n - 1) % n)));
+            std::uint32_t r2 = r1;
+            if (k == 0) r2 += static_cast<std::uint32_t>(N);
+            else if (k <= N) r2 += static_cast<std::uint32_t>(k % n) + v[k - 1];
+            else r2 += static_cast<std::uint32_t>(k % n);
+            at((k + p) % n) = static_cast<std::uint32_t>(at((k + p) % n) + r1);
+            at((k + q) % n) = static_cast<std::uint32_t>(at((k + q) % n) + r2);
+            at(k % n) = r2;
+        }
+        for (std::size_t k = m; k < m + n; ++k) {
+            const std::uint32_t r3 = 1566083941u * mix(static_cast<std::uint32_t>(at(k % n) + at((k + p) % n) + at((k + n - 1) % n)));
+            const std::uint32_t r4 = r3 - static_cast<std::uint32_t>(k % n);
+            at((k + p) % n) = static_cast<std::uint32_t>(at((k + p) % n) ^ r3);
+            at((k + q) % n) = static_cast<std::uint32_t>(at((k + q) % n) ^ r4);
+            at(k % n) = r4;
+        }
+    }
+};
 
 class MTEngRandNumGen {
 private:
     std::mt19937 dre;
     std::normal_distribution<double> norm;
+    std::normal_distribution<float> normSingle;
     
 public:
     MTEngRandNumGen() 
         : dre(std::random_device{}())
         , norm(0.0, 1.0) 
+        , normSingle(0.0f, 1.0f)
     {}
+
+    // Reproducible stream
+    explicit MTEngRandNumGen(std::uint64_t seed)
+        : norm(0.0, 1.0)
+        , normSingle(0.0f, 1.0f)
+    {
+        Seed(seed);
+    }
+
+    void Seed(std::uint64_t seed) {
+        FixedSeedSeq<2> seq({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+        dre.seed(seq);
+        norm.reset();
+        normSingle.reset();
+    }
     
+    // Substream `stream` of `seed`: path blocks and shards seed their own
+    // generator this way so results do not depend on scheduling. Reseeding
+    // does not allocate, so per-block reseeds cost only the state fill.
+    void SeedStream(std::uint64_t seed, std::uint64_t stream) {
+        FixedSeedSeq<5> seq({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                             static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32),
+                             0x5EEDu});
+        dre.seed(seq);
+        norm.reset();
+        normSingle.reset();
+    }
+
     double GenerateRandNum() {
         return norm(dre);
     }
+
+    // Uniform on the open interval (0, 1), never exactly 0 or 1
+    double GenerateUniform() {
+        return (static_cast<double>(dre()) + 0.5) * 0x1p-32;
+    }
+
+    // Float32 draw for the single precision simulation mode
+    float GenerateRandNumSingle() {
+        return normSingle(dre);
+    }
 };
 
 #endif
@@ -0,0 +1,77 @@
+#ifndef NormalCache_HPP
+#define NormalCache_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A fixed stream of standard normals, drawn once from MTEngRandNumGen(seed)
+// and replayed by any number of simulations. Runs that consume it the same
+// way see the same paths (common random numbers), so a price becomes a
+// deterministic, smooth function of the model parameters.
+//
+// The normals live in memory or in a file mapped read-only; the file is
+// written on first use and reused while its seed and length match, so large
+// caches are generated once and shared between processes.
+class NormalCache {
+public:
+    static std::shared_ptr<const NormalCache> InMemory(std::uint64_t seed, size_t count);
+    // Throws std::runtime_error if the file cannot be written or mapped
+    static std::shared_ptr<const NormalCache> Mapped(const std::string& fileName, std::uint64_t seed, size_t count);
+
+    ~NormalCache();
+    NormalCache(const NormalCache&) = delete;
+    NormalCache& operator=(const NormalCache&) = delete;
+
+    std::span<const double> Normals() const { return {data, count}; }
+    std::uint64_t Seed() const { return seed; }
+    bool IsMapped() const { return mapping != nullptr; }
+
+private:
+    NormalCache() = default;
+
+    std::vector<double> owned;
+    void* mapping{nullptr};
+    size_t mappedSize{0};
+    const double* data{nullptr};
+    size_t count{0};
+    std::uint64_t seed{0};
+};
+
+// RNG for MCCentralHub that replays a NormalCache from the start; throws once
+// the cache is exhausted rather than wrapping around
+class CachedNormalGen {
+private:
+    std::shared_ptr<const NormalCache> cache;
+    std::span<const double> normals;
+    size_t next{0};
+
+public:
+    explicit CachedNormalGen(std::shared_ptr<const NormalCache> normalCache)
+        : cache(std::move(normalCache))
+        , normals(cache->Normals())
+    {}
+
+    void Rewind() { next = 0; }
+    size_t Consumed() const { return next; }
+
+    double GenerateRandNum() {
+        if (next >= normals.size()) {
+            throw std::runtime_error("Normal cache exhausted");
+        }
+        return normals[next++];
+    }
+
+    // Uniform on (0, 1) from the next normal's tail probability
+    double GenerateUniform() {
+        const double u = 0.5 * std::erfc(-GenerateRandNum() / std::sqrt(2.0));
+        return std::clamp(u, 0x1p-53, 1.0 - 0x1p-53);
+    }
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef NumaTopology_HPP
+#define NumaTopology_HPP
+
+#include <string>
+#include <vector>
+
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;   // CPUs of the node this process may run on
+};
+
+// Host NUMA layout read from /sys/devices/system/node, restricted to the
+// process affinity mask. Hosts without that information (containers, non
+// Linux) are reported as one node holding every allowed CPU.
+class NumaTopology {
+public:
+    static NumaTopology Detect();
+
+    explicit NumaTopology(std::vector<NumaNode> numaNodes);
+
+    const std::vector<NumaNode>& Nodes() const { return nodes; }
+    size_t NumCpus() const;
+    int NodeOfCpu(int cpu) const;   // -1 if unknown
+
+    // One CPU per worker, spread round-robin over the nodes so a parallel
+    // run uses every socket's memory bandwidth
+    std::vector<int> SpreadPlacement(unsigned workers) const;
+
+    std::string Report() const;
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+    static std::vector<int> ParseCpuList(const std::string& list);
+
+private:
+    std::vector<NumaNode> nodes;
+};
+
+// Pins the calling thread to one CPU; false if the OS refused
+bool PinCurrentThread(int cpu);
+
+#endif
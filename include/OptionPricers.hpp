@@ -4,6 +4,7 @@
 #include <functional>
 #include <vector>
 #include <cmath>
+#include <cstdint>
 #include <numeric>
 #include "Pricer.hpp"
 
@@ -13,7 +14,7 @@ protected:
     alignas(64) struct Stats {  // Aligned for SIMD
         double sum{0.0};
         double squaredSum{0.0};
-        int count{0};
+        std::int64_t count{0};
         double price{0.0};
     };
     
@@ -41,7 +42,7 @@ public:
     std::tuple<double, double> StandardDeviationStats() {
         double totalSum = 0.0;
         double totalSquaredSum = 0.0;
-        int totalCount = 0;
+        std::int64_t totalCount = 0;
 
         for (const auto& stats : threadStats) {
             totalSum += stats.sum;
@@ -62,7 +63,7 @@ public:
         for (size_t i = 0; i < threadStats.size(); ++i) {
             auto& stats = threadStats[i];
             if (stats.count > 0) {
-                stats.price = (discountFactor * stats.sum) / stats.count;
+                stats.price = (discountFactor * stats.sum) / static_cast<double>(stats.count);
             }
         }
     }
@@ -0,0 +1,72 @@
+#ifndef PDESolver_HPP
+#define PDESolver_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "PricingProtocol.hpp"
+#include "SDEGeneral.hpp"
+
+// Crank-Nicolson finite differences for one-factor payoffs, a deterministic
+// alternative to Monte Carlo for European, down-and-out barrier and American
+// options under the same SDEGeneral drift and diffusion.
+//
+// The backward PDE V_t + drift V_S + 0.5 diffusion^2 V_SS - r V = 0 is solved
+// on a uniform grid in S from the payoff at T back to t = 0. The first steps
+// are implicit Euler half-steps (Rannacher start-up) so the payoff kink does
+// not ring through the Crank-Nicolson steps. Far boundaries assume V is
+// linear in S; a barrier 0 < OptionData::H < S_0 is a knock-out at the
+// grid's lower edge. Early exercise is a penalty iteration or PSOR.
+
+enum class ExerciseStyle { European, American };
+enum class EarlyExercise { Penalty, PSOR };
+
+struct PDEConfig {
+    size_t spaceSteps{400};
+    size_t timeSteps{200};
+    size_t rannacherSteps{2};        // leading steps taken as two implicit Euler half-steps
+    double width{5.0};               // upper edge at max(S_0, K) exp(width vol sqrt(T))
+    ExerciseStyle exercise{ExerciseStyle::European};
+    EarlyExercise method{EarlyExercise::Penalty};
+    double psorOmega{1.5};           // over-relaxation, 1 < omega < 2
+    double tolerance{1e-9};          // of the exercise iteration, relative to the option scale
+    int maxIterations{1000};         // per time step
+};
+
+struct PDEResult {
+    double price{0.0};
+    double delta{0.0};               // dV/dS at S_0
+    double gamma{0.0};               // d2V/dS2 at S_0
+    double theta{0.0};               // dV/dt at t = 0 (per year, usually negative)
+    std::vector<double> spots;       // grid nodes
+    std::vector<double> values;      // V(0, spots[i])
+    int exerciseIterations{0};       // summed over all time steps
+
+    // Quadratic interpolation of the grid at S (clamped to the grid)
+    double ValueAt(double S) const;
+};
+
+// Solves a x = d for a tridiagonal matrix with sub-diagonal lower[1..n-1],
+// diagonal diag and super-diagonal upper[0..n-2] (lower[0] and upper[n-1]
+// are ignored). scratch is resized to n; the matrix must not need pivoting,
+// which holds for the diagonally dominant systems of this engine.
+void SolveTridiagonal(const std::vector<double>& lower, const std::vector<double>& diag,
+                      const std::vector<double>& upper, const std::vector<double>& d,
+                      std::vector<double>& x, std::vector<double>& scratch);
+
+// Prices payoff(S_T) under sde, reading S_0, T, r, K and H from sde.data.
+// Throws std::runtime_error for jump SDEs and invalid configurations.
+PDEResult SolvePDE(const SDEGeneral& sde, const std::function<double(double)>& payoff,
+                   const PDEConfig& config = {});
+
+// Requests the PDE can price with the same contract the Monte Carlo pricers
+// apply: valid European requests without a barrier. The path pricers ignore
+// H, so requests with H != 0 stay on the simulation path; SolvePDE prices the
+// down-and-out directly.
+bool PDEEligible(const PricingRequest& req);
+
+// Prices an eligible request on the grid of config (req.NT and req.NSIM are
+// not used); stdDev, stdErr and paths are 0. BadRequest if not eligible.
+PricingResult PricePDE(const PricingRequest& req, const PDEConfig& config = {});
+
+#endif
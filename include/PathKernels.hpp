@@ -0,0 +1,157 @@
+#ifndef PathKernels_HPP
+#define PathKernels_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SDEGeneral.hpp"
+
+// Batched one-step kernels for CEV/GBM coefficients. x holds the state of n
+// paths at time t and is advanced in place by dt using the normals z. The
+// arithmetic is done in Real, so float blocks step in single precision and
+// vectorise at twice the width of double.
+
+template <typename Real, bool Lognormal>
+inline Real CEVDiffusion(Real x, Real sig, Real beta) {
+    if constexpr (Lognormal) {
+        return sig * x;
+    }
+    else {
+        return sig * std::pow(x, beta);
+    }
+}
+
+template <typename Real, bool Lognormal>
+void EulerBlockCEV(Real* __restrict x, const Real* __restrict z, size_t n,
+                   const CEVCoefficients& c, double dt) {
+    const Real mudt = static_cast<Real>(c.mu * dt);
+    const Real sig = static_cast<Real>(c.sig);
+    const Real beta = static_cast<Real>(c.beta);
+    const Real sqdt = static_cast<Real>(std::sqrt(dt));
+    for (size_t k = 0; k < n; ++k) {
+        const Real s = x[k];
+        x[k] = s + mudt * s + CEVDiffusion<Real, Lognormal>(s, sig, beta) * z[k] * sqdt;
+    }
+}
+
+// Same update as FDMLogEuler::next_n: the step's log-return with the local
+// volatility sig x^(beta - 1), exact for GBM
+template <typename Real, bool Lognormal>
+void LogEulerBlockCEV(Real* __restrict x, const Real* __restrict z, size_t n,
+                      const CEVCoefficients& c, double dt) {
+    const Real mu = static_cast<Real>(c.mu);
+    const Real sig = static_cast<Real>(c.sig);
+    const Real beta = static_cast<Real>(c.beta);
+    const Real h = static_cast<Real>(dt);
+    const Real sqdt = static_cast<Real>(std::sqrt(dt));
+    const Real half = static_cast<Real>(0.5);
+    for (size_t k = 0; k < n; ++k) {
+        const Real s = x[k];
+        const Real vol = CEVDiffusion<Real, Lognormal>(s, sig, beta) / s;
+        x[k] = s * std::exp((mu - half * vol * vol) * h + vol * z[k] * sqdt);
+    }
+}
+
+// Same update as FDMPredictCorrect::next_n, with SDEGeneral::driftCorrected
+// written out for CEV: x (mu - 0.5 sig^2 x^(2 beta - 2))
+template <typename Real, bool Lognormal>
+void PredictCorrectBlockCEV(Real* __restrict x, const Real* __restrict z, size_t n,
+                            const CEVCoefficients& c, double A, double B, double dt) {
+    const Real mu = static_cast<Real>(c.mu);
+    const Real sig = static_cast<Real>(c.sig);
+    const Real beta = static_cast<Real>(c.beta);
+    const Real a = static_cast<Real>(A);
+    const Real b = static_cast<Real>(B);
+    const Real h = static_cast<Real>(dt);
+    const Real sqdt = static_cast<Real>(std::sqrt(dt));
+    const Real half = static_cast<Real>(0.5);
+    const Real one = static_cast<Real>(1.0);
+    for (size_t k = 0; k < n; ++k) {
+        const Real s = x[k];
+        const Real diffOld = CEVDiffusion<Real, Lognormal>(s, sig, beta);
+        const Real euler = s + mu * s * h + diffOld * z[k] * sqdt;
+        const Real diffNew = CEVDiffusion<Real, Lognormal>(euler, sig, beta);
+
+        const Real volOld = diffOld / s;
+        const Real volNew = diffNew / euler;
+        const Real dcOld = s * (mu - half * volOld * volOld);
+        const Real dcNew = euler * (mu - half * volNew * volNew);
+
+        x[k] = s + (a * dcNew + (one - a) * dcOld) * h
+                 + (b * diffNew + (one - b) * diffOld) * z[k] * sqdt;
+    }
+}
+
+// Per-thread scratch for the local-vol kernels: the surface slice of the
+// current step and each block slot's spot cell. Hints left over from another
+// block or surface only cost a longer walk, never a wrong vol.
+template <typename Real>
+struct LocalVolScratch {
+    std::vector<double> level, slope, levelNext, slopeNext;
+    std::vector<std::uint32_t> hints;
+    std::vector<Real> vol, volNext, euler;
+
+    static LocalVolScratch& Get(size_t n) {
+        thread_local LocalVolScratch s;
+        if (s.hints.size() < n) {
+            s.hints.resize(n, 0);
+            s.vol.resize(n);
+            s.volNext.resize(n);
+            s.euler.resize(n);
+        }
+        return s;
+    }
+};
+
+template <typename Real>
+void EulerBlockLocalVol(Real* __restrict x, const Real* __restrict z, size_t n,
+                        const LocalVolCoefficients& c, double t, double dt) {
+    auto& s = LocalVolScratch<Real>::Get(n);
+    c.surface->SliceAt(t, s.level, s.slope);
+    c.surface->VolBlock(s.level.data(), s.slope.data(), x, n, s.hints.data(), s.vol.data());
+
+    const Real mudt = static_cast<Real>(c.mu * dt);
+    const Real sqdt = static_cast<Real>(std::sqrt(dt));
+    const Real* __restrict vol = s.vol.data();
+    for (size_t k = 0; k < n; ++k) {
+        const Real v = x[k];
+        x[k] = v + mudt * v + vol[k] * v * z[k] * sqdt;
+    }
+}
+
+// PredictCorrectBlockCEV with sigma(t, S) from the surface: the corrector
+// uses the vols of the Euler predictor at t + dt
+template <typename Real>
+void PredictCorrectBlockLocalVol(Real* __restrict x, const Real* __restrict z, size_t n,
+                                 const LocalVolCoefficients& c, double A, double B, double t, double dt) {
+    auto& s = LocalVolScratch<Real>::Get(n);
+    const Real mu = static_cast<Real>(c.mu);
+    const Real a = static_cast<Real>(A);
+    const Real b = static_cast<Real>(B);
+    const Real h = static_cast<Real>(dt);
+    const Real sqdt = static_cast<Real>(std::sqrt(dt));
+    const Real half = static_cast<Real>(0.5);
+    const Real one = static_cast<Real>(1.0);
+
+    c.surface->SliceAt(t, s.level, s.slope);
+    c.surface->SliceAt(t + dt, s.levelNext, s.slopeNext);
+    c.surface->VolBlock(s.level.data(), s.slope.data(), x, n, s.hints.data(), s.vol.data());
+    Real* __restrict euler = s.euler.data();
+    const Real* __restrict volOld = s.vol.data();
+    for (size_t k = 0; k < n; ++k) {
+        euler[k] = x[k] + mu * x[k] * h + volOld[k] * x[k] * z[k] * sqdt;
+    }
+    // The predictor is close to x, so the same hints serve the second lookup
+    c.surface->VolBlock(s.levelNext.data(), s.slopeNext.data(), euler, n, s.hints.data(), s.volNext.data());
+    const Real* __restrict volNew = s.volNext.data();
+    for (size_t k = 0; k < n; ++k) {
+        const Real v = x[k];
+        const Real dcOld = v * (mu - half * volOld[k] * volOld[k]);
+        const Real dcNew = euler[k] * (mu - half * volNew[k] * volNew[k]);
+        x[k] = v + (a * dcNew + (one - a) * dcOld) * h
+                 + (b * volNew[k] * euler[k] + (one - b) * volOld[k] * v) * z[k] * sqdt;
+    }
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef PathStatistics_HPP
+#define PathStatistics_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
+// Undiscounted payoff accumulators. Estimates built from disjoint sets of
+// paths combine exactly with Merge.
+struct PathStatistics {
+    double sum{0.0};
+    double squaredSum{0.0};
+    std::int64_t count{0};
+
+    void Add(double payoff) {
+        sum += payoff;
+        squaredSum += payoff * payoff;
+        ++count;
+    }
+
+    void Merge(const PathStatistics& other) {
+        sum += other.sum;
+        squaredSum += other.squaredSum;
+        count += other.count;
+    }
+
+    double Price(double discountFactor) const {
+        if (count == 0) return 0.0;
+        return (discountFactor * sum) / static_cast<double>(count);
+    }
+
+    // Same convention as Pricer::StandardDeviationStats (undiscounted payoffs)
+    std::tuple<double, double> StandardDeviationStats() const {
+        if (count < 2) return {0.0, 0.0};
+
+        const double M = static_cast<double>(count);
+        const double SD = std::sqrt(std::max(0.0, (squaredSum / M) - (sum * sum) / (M * M)));
+        const double SE = SD / std::sqrt(M);
+
+        return {SD, SE};
+    }
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef PathStore_HPP
+#define PathStore_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+#include "OptionData.hpp"
+#include "PricingProtocol.hpp"
+#include "Precision.hpp"
+
+// On-disk store of simulated paths for simulate-once, price-many workflows.
+//
+// File layout (native endianness):
+//   PathStoreHeader
+//   double   times[pathSize]             time grid
+//   uint64_t observations[numObservations]
+//   padding to a 64-byte boundary
+//   values   numPaths x pathSize          path-major: one contiguous row per
+//                                         path, float64 or float32
+// numPaths is patched into the header when the writer is closed.
+//
+// The values are deliberately not stored step-major (one column per time
+// step): replay hands every pricer a whole path, and path-major rows let
+// Path(i) return a zero-copy std::span straight into the mapping.
+
+struct PathStoreInfo {
+    OptionData option{};                  // SDE parameters the paths were simulated with
+    SchemeType scheme{SchemeType::PredictorCorrector};
+    std::uint64_t seed{0};
+    std::vector<double> times;            // grid, size = path length
+    std::vector<size_t> observations;     // observation indices into the grid
+};
+
+struct PathStoreHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t precision;              // bytes per value, see Precision
+    std::uint64_t numPaths;
+    std::uint64_t pathSize;
+    std::uint64_t numObservations;
+    std::uint64_t dataOffset;
+    std::uint64_t seed;
+    std::int32_t scheme;
+    std::int32_t optionType;
+    double S_0, K, T, r, sig, D, H, betaCEV, scale;
+};
+static_assert(sizeof(PathStoreHeader) == 136, "PathStoreHeader layout must not change");
+
+class PathStoreWriter {
+public:
+    // Creates/truncates the file and writes header and grid; throws std::runtime_error
+    PathStoreWriter(const std::string& fileName, PathStoreInfo info, Precision precision = Precision::Double);
+    ~PathStoreWriter();
+
+    PathStoreWriter(const PathStoreWriter&) = delete;
+    PathStoreWriter& operator=(const PathStoreWriter&) = delete;
+
+    void Append(std::span<const double> path);
+    // Patches the path count into the header and closes the file
+    void Close();
+
+    const PathStoreInfo& Info() const { return info; }
+    std::uint64_t PathsWritten() const { return numPaths; }
+
+private:
+    std::FILE* file{nullptr};
+    PathStoreInfo info;
+    Precision precision;
+    std::uint64_t numPaths{0};
+    std::vector<float> floatBuffer;
+};
+
+// Read-only memory-mapped view of a path store
+class PathStoreReader {
+public:
+    explicit PathStoreReader(const std::string& fileName);
+    ~PathStoreReader();
+
+    PathStoreReader(const PathStoreReader&) = delete;
+    PathStoreReader& operator=(const PathStoreReader&) = delete;
+
+    const PathStoreInfo& Info() const { return info; }
+    Precision GetPrecision() const { return precision; }
+    std::uint64_t NumPaths() const { return numPaths; }
+    size_t PathSize() const { return pathSize; }
+
+    // Zero-copy views into the mapping; use the one matching GetPrecision()
+    std::span<const double> Path(std::uint64_t i) const {
+        return {static_cast<const double*>(data) + i * pathSize, pathSize};
+    }
+    std::span<const float> PathSingle(std::uint64_t i) const {
+        return {static_cast<const float*>(data) + i * pathSize, pathSize};
+    }
+
+private:
+    void* mapping{nullptr};
+    size_t mappedSize{0};
+    const void* data{nullptr};
+    PathStoreInfo info;
+    Precision precision{Precision::Double};
+    std::uint64_t numPaths{0};
+    size_t pathSize{0};
+};
+
+// Describes paths produced by an MCCentralHub run with this scheme and seed
+template <typename FDM>
+PathStoreInfo MakePathStoreInfo(const OptionData& option, const FDM& fdm, SchemeType scheme, std::uint64_t seed) {
+    return PathStoreInfo{option, scheme, seed, fdm.getTimePoints(), fdm.getObservationIndices()};
+}
+
+// Streams every stored path into the pricer and finalises it. float64 stores
+// are handed over straight from the mapping; float32 paths are widened into
+// one reused buffer.
+template <typename Pricer>
+void ReplayPaths(const PathStoreReader& store, Pricer& pricer) {
+    pricer.SetObservationIndices(store.Info().observations);
+    if (store.GetPrecision() == Precision::Double) {
+        for (std::uint64_t i = 0; i < store.NumPaths(); ++i) {
+            pricer.GeneratePath(store.Path(i));
+        }
+    }
+    else {
+        std::vector<double> buffer(store.PathSize());
+        for (std::uint64_t i = 0; i < store.NumPaths(); ++i) {
+            const auto p = store.PathSingle(i);
+            for (size_t j = 0; j < p.size(); ++j) {
+                buffer[j] = static_cast<double>(p[j]);
+            }
+            pricer.GeneratePath(buffer);
+        }
+    }
+    pricer.AfterPathCleanUp();
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef PayoffExpression_HPP
+#define PayoffExpression_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "StreamingPricer.hpp"
+
+// Path-functional payoffs as expression templates.
+//
+// An expression is built from path primitives (Terminal, Average, PathMax,
+// PathMin, HitAbove, HitBelow) and numbers with + - * /, Max and Min, e.g.
+//
+//   Min(Max(Average() - 100.0, 0.0), 30.0)                  capped Asian call
+//   PathMax() - Terminal()                                  floating lookback put
+//   (1.0 - HitBelow(80.0)) * Max(Average() - 100.0, 0.0)    down-and-out Asian
+//
+// Every node carries a small running state (a sum, an extremum, a hit flag)
+// and the whole tree's state is one flat struct. Observe() folds one grid
+// point into it, Value() evaluates the payoff at the end; the compiler
+// inlines the tree into a single update per point. ExpressionPricer runs this
+// update while MCCentralHub steps a block of paths, so path-dependent payoffs
+// need neither stored paths nor extra passes. Barriers are monitored on the
+// grid points.
+
+namespace payoff {
+
+// Base of all nodes; enables the operators below
+struct Node {};
+
+template <typename T>
+concept Expression = std::derived_from<std::remove_cvref_t<T>, Node>;
+
+// Value of the underlying at grid point j, and whether j is an averaging date
+struct Point {
+    double x;
+    bool averaged;
+};
+
+struct Constant : Node {
+    double c;
+    struct State {};
+    explicit Constant(double value) : c(value) {}
+    void Observe(State&, Point) const {}
+    double Value(const State&) const { return c; }
+};
+
+struct Terminal : Node {
+    struct State { double last{0.0}; };
+    void Observe(State& s, Point p) const { s.last = p.x; }
+    double Value(const State& s) const { return s.last; }
+};
+
+// Arithmetic average over the averaging dates (the pricer's observation
+// schedule, or every point but the last as in AsianOptionPricer)
+struct Average : Node {
+    struct State {
+        double sum{0.0};
+        double count{0.0};
+    };
+    void Observe(State& s, Point p) const {
+        if (p.averaged) {
+            s.sum += p.x;
+            s.count += 1.0;
+        }
+    }
+    double Value(const State& s) const { return s.count > 0.0 ? s.sum / s.count : 0.0; }
+};
+
+// Extremes over every grid point including S_0 and the terminal value.
+// Finite sentinels: -ffast-math assumes there are no infinities.
+struct PathMax : Node {
+    struct State { double m{std::numeric_limits<double>::lowest()}; };
+    void Observe(State& s, Point p) const { s.m = std::max(s.m, p.x); }
+    double Value(const State& s) const { return s.m; }
+};
+
+struct PathMin : Node {
+    struct State { double m{std::numeric_limits<double>::max()}; };
+    void Observe(State& s, Point p) const { s.m = std::min(s.m, p.x); }
+    double Value(const State& s) const { return s.m; }
+};
+
+// 1 once the path has touched the barrier at a grid point, else 0
+template <bool Above>
+struct Hit : Node {
+    double barrier;
+    struct State { bool hit{false}; };
+    explicit Hit(double level) : barrier(level) {}
+    void Observe(State& s, Point p) const { s.hit = s.hit || (Above ? p.x >= barrier : p.x <= barrier); }
+    double Value(const State& s) const { return s.hit ? 1.0 : 0.0; }
+};
+
+using HitAbove = Hit<true>;
+using HitBelow = Hit<false>;
+
+template <typename Op, typename L, typename R>
+struct Binary : Node {
+    L lhs;
+    R rhs;
+    struct State {
+        typename L::State l;
+        typename R::State r;
+    };
+    Binary(L a, R b) : lhs(std::move(a)), rhs(std::move(b)) {}
+    void Observe(State& s, Point p) const {
+        lhs.Observe(s.l, p);
+        rhs.Observe(s.r, p);
+    }
+    double Value(const State& s) const { return Op{}(lhs.Value(s.l), rhs.Value(s.r)); }
+};
+
+template <typename E>
+struct Negate : Node {
+    E e;
+    using State = typename E::State;
+    explicit Negate(E inner) : e(std::move(inner)) {}
+    void Observe(State& s, Point p) const { e.Observe(s, p); }
+    double Value(const State& s) const { return -e.Value(s); }
+};
+
+struct MaxOp {
+    double operator()(double a, double b) const { return std::max(a, b); }
+};
+
+struct MinOp {
+    double operator()(double a, double b) const { return std::min(a, b); }
+};
+
+// Numbers become Constant nodes
+template <Expression E>
+E Lift(E e) { return e; }
+inline Constant Lift(double c) { return Constant(c); }
+
+template <typename T>
+concept Operand = Expression<T> || std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+template <typename A, typename B>
+concept ExpressionPair = Operand<A> && Operand<B> && (Expression<A> || Expression<B>);
+
+template <typename Op, typename A, typename B>
+auto MakeBinary(A a, B b) {
+    auto l = Lift(a);
+    auto r = Lift(b);
+    return Binary<Op, decltype(l), decltype(r)>(std::move(l), std::move(r));
+}
+
+template <typename A, typename B> requires ExpressionPair<A, B>
+auto operator+(A a, B b) { return MakeBinary<std::plus<double>>(a, b); }
+
+template <typename A, typename B> requires ExpressionPair<A, B>
+auto operator-(A a, B b) { return MakeBinary<std::minus<double>>(a, b); }
+
+template <typename A, typename B> requires ExpressionPair<A, B>
+auto operator*(A a, B b) { return MakeBinary<std::multiplies<double>>(a, b); }
+
+template <typename A, typename B> requires ExpressionPair<A, B>
+auto operator/(A a, B b) { return MakeBinary<std::divides<double>>(a, b); }
+
+template <Expression E>
+auto operator-(E e) { return Negate<E>(std::move(e)); }
+
+template <typename A, typename B> requires ExpressionPair<A, B>
+auto Max(A a, B b) { return MakeBinary<MaxOp>(a, b); }
+
+template <typename A, typename B> requires ExpressionPair<A, B>
+auto Min(A a, B b) { return MakeBinary<MinOp>(a, b); }
+
+// Evaluates an expression on a stored path; averaging dates as in ExpressionPricer
+template <Expression E>
+double Evaluate(const E& expr, std::span<const double> path, const std::vector<size_t>& observations = {}) {
+    std::vector<char> averaged(path.size(), observations.empty() ? 1 : 0);
+    if (observations.empty() && !path.empty()) averaged.back() = 0;
+    for (size_t idx : observations) {
+        if (idx < path.size()) averaged[idx] = 1;
+    }
+    typename E::State s{};
+    for (size_t j = 0; j < path.size(); ++j) {
+        expr.Observe(s, Point{path[j], averaged[j] != 0});
+    }
+    return expr.Value(s);
+}
+
+} // namespace payoff
+
+// Prices a payoff expression in one streaming pass over each block
+template <payoff::Expression E>
+class ExpressionPricer : public StreamingPricer {
+private:
+    E expr;
+    std::vector<typename E::State> states;
+    std::vector<char> averaged;   // per grid index, for the current path size
+
+    void Schedule(size_t pathSize) {
+        if (averaged.size() == pathSize) return;
+        averaged.assign(pathSize, 0);
+        if (m_observations.empty() && pathSize > 0) {
+            std::fill(averaged.begin(), averaged.end() - 1, 1);
+        }
+        for (size_t idx : m_observations) {
+            if (idx < pathSize) averaged[idx] = 1;
+        }
+    }
+
+    template <typename Real>
+    void ObserveBlock(size_t j, const Real* x, size_t n) {
+        const bool avg = averaged[j] != 0;
+        for (size_t k = 0; k < n; ++k) {
+            expr.Observe(states[k], payoff::Point{static_cast<double>(x[k]), avg});
+        }
+    }
+
+public:
+    ExpressionPricer(E expression, std::function<double()>& dis)
+        : expr(std::move(expression))
+    {
+        m_discount = dis;
+    }
+
+    void SetObservationIndices(const std::vector<size_t>& indices) override {
+        Pricer::SetObservationIndices(indices);
+        averaged.clear();
+    }
+
+    void GeneratePath(std::span<const double> vec) override {
+        BeginBlock(vec.size(), 1);
+        for (size_t j = 0; j < vec.size(); ++j) {
+            ObserveBlock(j, &vec[j], 1);
+        }
+        EndBlock(1);
+    }
+
+    void BeginBlock(size_t pathSize, size_t n) override {
+        Schedule(pathSize);
+        states.assign(n, typename E::State{});
+    }
+
+    void Observe(size_t j, const double* x, size_t n) override { ObserveBlock(j, x, n); }
+    void Observe(size_t j, const float* x, size_t n) override { ObserveBlock(j, x, n); }
+
+    void EndBlock(size_t n) override {
+        for (size_t k = 0; k < n; ++k) {
+            updateStats(expr.Value(states[k]));
+        }
+    }
+
+    void AfterPathCleanUp() override {}
+
+    const E& Expr() const { return expr; }
+};
+
+template <payoff::Expression E>
+std::shared_ptr<ExpressionPricer<E>> MakeExpressionPricer(E expr, double discountFactor) {
+    std::function<double()> discount = [discountFactor]() { return discountFactor; };
+    return std::make_shared<ExpressionPricer<E>>(std::move(expr), discount);
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef PerfCounters_HPP
+#define PerfCounters_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// Hardware counters (cycles, instructions, branch misses, LLC misses) per
+// simulation phase and per thread, through Linux perf_event_open.
+//
+// Counting is optional and degrades gracefully: where perf events are not
+// available (other OS, perf_event_paranoid, seccomp, no PMU in a VM) the
+// counters read as invalid and only wall time is reported. Counters are
+// opened for user space of the calling thread only, so each thread measures
+// its own work and no special privileges are needed at paranoid <= 2.
+
+enum class PerfEvent : size_t { Cycles = 0, Instructions, BranchMisses, LLCMisses };
+constexpr size_t NumPerfEvents = 4;
+
+const char* PerfEventName(PerfEvent e);
+
+struct PerfSample {
+    std::array<std::uint64_t, NumPerfEvents> values{};
+    std::array<bool, NumPerfEvents> valid{};
+    double seconds{0.0};
+
+    std::uint64_t operator[](PerfEvent e) const { return values[static_cast<size_t>(e)]; }
+    bool Has(PerfEvent e) const { return valid[static_cast<size_t>(e)]; }
+
+    // Counter deltas; an event is valid only if it is valid in both samples
+    PerfSample operator-(const PerfSample& start) const;
+    PerfSample& operator+=(const PerfSample& other);
+};
+
+// The counters of the calling thread. Not thread safe: use one per thread
+// (ThreadPerfCounters() keeps one in thread-local storage).
+class PerfCounterGroup {
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool Available() const;          // at least one hardware event opened
+    PerfSample Read() const;         // running totals, scaled for multiplexing
+
+    // Why counters are missing, e.g. "perf_event_open: Permission denied"
+    const std::string& Status() const { return status; }
+
+private:
+    std::array<int, NumPerfEvents> fds;
+    std::chrono::steady_clock::time_point start;
+    std::string status;
+};
+
+PerfCounterGroup& ThreadPerfCounters();
+
+// Counter totals per (phase, thread) with the paths and steps they covered.
+// Thread safe; threads are numbered in the order they first record.
+class PerfProfile {
+public:
+    struct Entry {
+        std::string phase;
+        size_t thread{0};
+        PerfSample counters;
+        std::int64_t paths{0};
+        std::int64_t steps{0};     // path steps: paths x time steps
+    };
+
+    void Record(const std::string& phase, const PerfSample& delta, std::int64_t paths, std::int64_t steps);
+
+    // Per (phase, thread) entries, or summed over threads
+    std::vector<Entry> Entries() const;
+    std::vector<Entry> PhaseTotals() const;
+
+    // Table of per-path and per-step rates (cycles, instructions, IPC, branch
+    // and LLC misses, ns); perThread adds one row per thread under each phase
+    std::string Report(bool perThread = false) const;
+
+    void Clear();
+
+private:
+    mutable std::mutex mtx;
+    std::map<std::thread::id, size_t> threads;
+    std::map<std::tuple<std::string, size_t>, Entry> entries;
+};
+
+// Counts the calling thread's events from construction to destruction into
+// profile under phase; does nothing if profile is null
+class ScopedPerfPhase {
+public:
+    ScopedPerfPhase(PerfProfile* profile, const char* phase, std::int64_t paths, std::int64_t steps);
+    ~ScopedPerfPhase();
+
+    ScopedPerfPhase(const ScopedPerfPhase&) = delete;
+    ScopedPerfPhase& operator=(const ScopedPerfPhase&) = delete;
+
+    // For phases whose amount of work is only known at the end
+    void SetWork(std::int64_t numPaths, std::int64_t numSteps) {
+        paths = numPaths;
+        steps = numSteps;
+    }
+
+private:
+    PerfProfile* profile;
+    const char* phase;
+    std::int64_t paths;
+    std::int64_t steps;
+    PerfSample start;
+};
+
+#endif
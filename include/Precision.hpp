@@ -0,0 +1,13 @@
+#ifndef Precision_HPP
+#define Precision_HPP
+
+#include <cstdint>
+
+// Floating point width of stored/simulated path values; the value is the
+// size in bytes of one element
+enum class Precision : std::uint32_t {
+    Double = 8,
+    Single = 4
+};
+
+#endif
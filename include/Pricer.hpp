@@ -3,17 +3,23 @@
 
 #include <functional>
 #include <vector>
+#include <span>
 #include <tuple>
 #include <mutex>
 #include <cmath>
+#include <cstdint>
+#include "PathStatistics.hpp"
 class Pricer {
 protected:
     std::mutex mtx;
     double sum{0.0};
     double squaredSum{0.0};
-    int count{0};
+    std::int64_t count{0};
     std::function<double(double)> m_payoffFunction;
     std::function<double()> m_discount;
+    std::vector<size_t> m_observations;  // fixing indices into the path, empty = pricer default
+    double m_pathWeight{1.0};            // likelihood ratio of the current path
+    double m_lastPayoff{0.0};            // unweighted payoff of the last path
 
 public:
     Pricer() = default;
@@ -25,16 +31,55 @@ public:
 
     virtual ~Pricer() = default;
 
-    virtual void GeneratePath(const std::vector<double>& vec) = 0;
+    virtual void GeneratePath(std::span<const double> vec) = 0;
     virtual void AfterPathCleanUp() = 0;
+
+    // Called by the hub with the grid's observation dates before simulating
+    virtual void SetObservationIndices(const std::vector<size_t>& indices) {
+        m_observations = indices;
+    }
     
+    // Importance sampling: the next payoffs are weighted by w until it changes
+    virtual void SetPathWeight(double w) {
+        m_pathWeight = w;
+    }
+
+    // Undiscounted, unweighted payoff of the path last passed to GeneratePath
+    virtual double LastPayoff() const {
+        return m_lastPayoff;
+    }
+
     double DiscountFactor() {
         return m_discount();
     }
 
     double OptionPrice() {
         if (count == 0) return 0.0;
-        return (DiscountFactor() * sum) / count;
+        return (DiscountFactor() * sum) / static_cast<double>(count);
+    }
+
+    std::int64_t PathCount() const {
+        return count;
+    }
+
+    PathStatistics Statistics() const {
+        return PathStatistics{sum, squaredSum, count};
+    }
+
+    // Drops every accumulated path, for a pricer reused for another run
+    void ResetStatistics() {
+        std::lock_guard<std::mutex> lock(mtx);
+        sum = 0.0;
+        squaredSum = 0.0;
+        count = 0;
+    }
+
+    // Folds in accumulators from paths simulated elsewhere (another block, a cached run)
+    void MergeStatistics(const PathStatistics& other) {
+        std::lock_guard<std::mutex> lock(mtx);
+        sum += other.sum;
+        squaredSum += other.squaredSum;
+        count += other.count;
     }
 
     std::tuple<double, double> StandardDeviationStats() {
@@ -49,6 +94,8 @@ public:
 
 protected:
     void updateStats(double payoff) {
+        m_lastPayoff = payoff;
+        payoff *= m_pathWeight;
         std::lock_guard<std::mutex> lock(mtx);
         sum += payoff;
         squaredSum += payoff * payoff;
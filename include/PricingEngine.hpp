@@ -0,0 +1,192 @@
+#ifndef PricingEngine_HPP
+#define PricingEngine_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include "OptionData.hpp"
+#include "SDEGeneral.hpp"
+#include "FDMType.hpp"
+#include "FDMEuler.hpp"
+#include "FDMLogEuler.hpp"
+#include "FDMPredictCorrect.hpp"
+#include "LocalVolSurface.hpp"
+#include "Pricer.hpp"
+#include "EuropeanOptionPricer.hpp"
+#include "AsianOptionPricer.hpp"
+#include "CompositePricer.hpp"
+#include "MCCentralHub.hpp"
+#include "MTEngRandNumGen.hpp"
+#include "PricingProtocol.hpp"
+
+// Builds the standard model pieces from an OptionData (the same setup as
+// main.cpp) and prices batches of requests that share one underlying.
+
+// CEV dS = mu S dt + sig S^beta dW, GBM when betaCEV == 1
+inline std::shared_ptr<SDEGeneral> MakeCEVSDE(const OptionData& o, double mu) {
+    const double sig = o.sig;
+    const double beta = o.betaCEV;
+
+    InputFunction drift = [mu]([[maybe_unused]] double t, double S) { return mu * S; };
+    InputFunction diffusion;
+    InputFunction diffusionDerivative;
+    if (beta == 1.0) {
+        diffusion = [sig]([[maybe_unused]] double t, double S) { return sig * S; };
+        diffusionDerivative = [sig]([[maybe_unused]] double t, [[maybe_unused]] double S) { return sig; };
+    }
+    else {
+        diffusion = [sig, beta]([[maybe_unused]] double t, double S) { return sig * std::pow(S, beta); };
+        diffusionDerivative = [sig, beta]([[maybe_unused]] double t, double S) {
+            return sig * beta * std::pow(S, beta - 1.0);
+        };
+    }
+    InputFunction driftCorrected = [drift, diffusion, diffusionDerivative](double t, double S) {
+        return drift(t, S) - 0.5 * diffusion(t, S) * diffusionDerivative(t, S);
+    };
+
+    auto sdeParams = std::make_tuple(drift, diffusion, driftCorrected, diffusionDerivative);
+    auto sde = std::make_shared<SDEGeneral>(sdeParams, o);
+    sde->closedForm = CEVCoefficients{mu, sig, beta};
+    return sde;
+}
+
+// GBM, or CEV dS = (r - D) S dt + sig S^beta dW when betaCEV != 1
+inline std::shared_ptr<SDEGeneral> MakeSDE(const OptionData& o) {
+    return MakeCEVSDE(o, o.r - o.D);
+}
+
+// Merton or Kou jump diffusion: the GBM/CEV diffusion of MakeSDE with drift
+// r - D - lambda kappa, plus the jumps, which MCCentralHub applies per path
+inline std::shared_ptr<SDEGeneral> MakeJumpDiffusionSDE(const OptionData& o, const JumpCoefficients& jumps) {
+    jumps.Validate();
+    auto sde = MakeCEVSDE(o, o.r - o.D - jumps.intensity * jumps.Compensator());
+    sde->jumps = jumps;
+    return sde;
+}
+
+// dS = (r - D) S dt + sigma(t, S) S dW with sigma from the surface; o.sig is
+// ignored. The std::function coefficients serve path-by-path stepping, block
+// mode steps through the surface slices.
+inline std::shared_ptr<SDEGeneral> MakeLocalVolSDE(const OptionData& o,
+                                                   std::shared_ptr<const LocalVolSurface> surface) {
+    if (!surface) {
+        throw std::runtime_error("Local vol SDE needs a surface");
+    }
+    const double mu = o.r - o.D;
+
+    InputFunction drift = [mu]([[maybe_unused]] double t, double S) { return mu * S; };
+    InputFunction diffusion = [surface](double t, double S) { return surface->Vol(t, S) * S; };
+    InputFunction diffusionDerivative = [surface](double t, double S) {
+        double dVolDS = 0.0;
+        const double vol = surface->Vol(t, S, &dVolDS);
+        return vol + S * dVolDS;
+    };
+    InputFunction driftCorrected = [drift, diffusion, diffusionDerivative](double t, double S) {
+        return drift(t, S) - 0.5 * diffusion(t, S) * diffusionDerivative(t, S);
+    };
+
+    auto sdeParams = std::make_tuple(drift, diffusion, driftCorrected, diffusionDerivative);
+    auto sde = std::make_shared<SDEGeneral>(sdeParams, o);
+    sde->localVol = LocalVolCoefficients{mu, std::move(surface)};
+    return sde;
+}
+
+inline std::shared_ptr<FDMType> MakeFDM(std::shared_ptr<SDEGeneral>& sde, SchemeType scheme, int NT) {
+    if (scheme == SchemeType::Euler) {
+        return std::make_shared<FDMEuler>(sde, NT);
+    }
+    if (scheme == SchemeType::LogEuler) {
+        return std::make_shared<FDMLogEuler>(sde, NT);
+    }
+    return std::make_shared<FDMPredictCorrect>(sde, NT);
+}
+
+inline std::function<double(double)> MakePayoff(const OptionData& o) {
+    const double K = o.K;
+    if (o.type == -1) {
+        return [K](double s) { return std::max<double>(0.0, K - s); };
+    }
+    return [K](double s) { return std::max<double>(0.0, s - K); };
+}
+
+inline std::shared_ptr<Pricer> MakePricer(const PricingRequest& req) {
+    auto payoff = MakePayoff(req.option);
+    const double df = std::exp(-req.option.r * req.option.T);
+    std::function<double()> discount = [df]() { return df; };
+    if (req.style == PayoffStyle::Asian) {
+        return std::make_shared<AsianOptionPricer>(payoff, discount);
+    }
+    return std::make_shared<EuropeanOptionPricer>(payoff, discount);
+}
+
+// Tested on the bits: -ffast-math lets the compiler fold std::isfinite to true
+inline bool FiniteValue(double v) {
+    constexpr std::uint64_t exponent = 0x7FF0000000000000ull;
+    return (std::bit_cast<std::uint64_t>(v) & exponent) != exponent;
+}
+
+inline bool ValidRequest(const PricingRequest& req) {
+    const OptionData& o = req.option;
+    // A NaN rate or dividend would otherwise come back as a NaN price with status Ok
+    for (double v : {o.K, o.T, o.r, o.sig, o.D, o.S_0, o.H, o.betaCEV, o.scale}) {
+        if (!FiniteValue(v)) return false;
+    }
+    return o.T > 0.0 && o.S_0 > 0.0 && o.K >= 0.0 && o.sig >= 0.0
+        && (o.type == 1 || o.type == -1)
+        && req.NT > 0 && req.NT <= MaxRequestSteps && req.NSIM > 0;
+}
+
+// Prices every request in the batch on one set of paths. All requests must
+// share UnderlyingKey(); the first request's seed (if non-zero) reseeds rng.
+// Optionally returns each request's raw payoff accumulators.
+inline std::vector<PricingResult> PriceBatch(const std::vector<PricingRequest>& batch,
+                                             std::shared_ptr<MTEngRandNumGen>& rng,
+                                             std::vector<PathStatistics>* stats = nullptr) {
+    std::vector<PricingResult> results(batch.size());
+    if (stats) stats->assign(batch.size(), PathStatistics{});
+    if (batch.empty()) return results;
+
+    auto composite = std::make_shared<CompositePricer>();
+    std::vector<size_t> priced;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!ValidRequest(batch[i]) || !SameUnderlying(batch[i], batch[0])) {
+            results[i].status = PricingStatus::BadRequest;
+            continue;
+        }
+        composite->Add(MakePricer(batch[i]));
+        priced.push_back(i);
+    }
+    if (priced.empty()) return results;
+
+    const PricingRequest& lead = batch[priced.front()];
+    if (lead.seed != 0) {
+        rng->Seed(lead.seed);
+    }
+
+    auto sde = MakeSDE(lead.option);
+    auto fdm = MakeFDM(sde, lead.scheme, lead.NT);
+    std::shared_ptr<Pricer> pricer = composite;
+    auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+    MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, lead.NSIM);
+    hub.SetVerbose(false);
+    hub.BeginSimulation();
+
+    for (size_t k = 0; k < priced.size(); ++k) {
+        auto& child = composite->Children()[k];
+        auto& res = results[priced[k]];
+        const auto [sd, se] = child->StandardDeviationStats();
+        res.price = child->OptionPrice();
+        res.stdDev = sd;
+        res.stdErr = se;
+        res.paths = child->PathCount();
+        if (stats) (*stats)[priced[k]] = child->Statistics();
+    }
+    return results;
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef PricingProtocol_HPP
+#define PricingProtocol_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include "OptionData.hpp"
+
+// Request/response types shared by the pricing service, its clients and the
+// batch pricing engine. On the wire they travel as fixed-size frames
+// (WireRequest/WireResponse) copied in host byte order, no framing beyond the
+// magic word; the Unix socket transport never crosses machines.
+
+enum class PayoffStyle : std::int32_t { European = 0, Asian = 1 };
+enum class SchemeType : std::int32_t { Euler = 0, PredictorCorrector = 1, LogEuler = 2 };
+
+enum class PricingStatus : std::int32_t {
+    Ok = 0,
+    BadRequest = 1,
+    InternalError = 2,
+    Cancelled = 3        // stopped early; price/paths cover the paths finished
+};
+
+// Upper bound on time steps per request: caps the per-path buffer a single
+// request can make a worker allocate
+constexpr std::int32_t MaxRequestSteps = 100000;
+
+// Default upper bound on paths per pricing service request: caps how long a
+// single socket request can keep a worker busy. Larger runs go through
+// ShardRun, whose shards are checkpointed and can be stopped.
+constexpr std::int64_t MaxRequestPaths = 100'000'000;
+
+struct PricingRequest {
+    OptionData option;
+    PayoffStyle style{PayoffStyle::European};
+    SchemeType scheme{SchemeType::PredictorCorrector};
+    std::int32_t NT{1000};
+    std::int64_t NSIM{50000};
+    std::uint64_t seed{0};   // 0 = continue the worker's current stream
+};
+
+struct PricingResult {
+    PricingStatus status{PricingStatus::Ok};
+    double price{0.0};
+    double stdDev{0.0};
+    double stdErr{0.0};
+    std::int64_t paths{0};
+};
+
+// Requests with equal underlying keys can share one set of simulated paths:
+// everything that drives the SDE, grid and random numbers, but not K/type/style
+inline auto UnderlyingKey(const PricingRequest& r) {
+    const OptionData& o = r.option;
+    return std::make_tuple(o.S_0, o.T, o.r, o.sig, o.D, o.betaCEV, o.scale,
+                           r.scheme, r.NT, r.NSIM, r.seed);
+}
+
+inline bool SameUnderlying(const PricingRequest& a, const PricingRequest& b) {
+    return UnderlyingKey(a) == UnderlyingKey(b);
+}
+
+constexpr std::uint32_t WireRequestMagic = 0x5152434D;   // "MCRQ"
+constexpr std::uint32_t WireResponseMagic = 0x5352434D;  // "MCRS"
+constexpr std::uint32_t WireVersion = 1;
+
+struct WireRequest {
+    std::uint32_t magic;
+    std::uint32_t version;
+    double K, T, r, sig, D, S_0, H, betaCEV, scale;
+    std::int32_t type;
+    std::int32_t style;
+    std::int32_t scheme;
+    std::int32_t NT;
+    std::int64_t NSIM;
+    std::uint64_t seed;
+};
+static_assert(sizeof(WireRequest) == 112, "WireRequest layout must not change");
+
+struct WireResponse {
+    std::uint32_t magic;
+    std::int32_t status;
+    double price;
+    double stdDev;
+    double stdErr;
+    std::int64_t paths;
+};
+static_assert(sizeof(WireResponse) == 40, "WireResponse layout must not change");
+
+inline WireRequest EncodeRequest(const PricingRequest& req) {
+    const OptionData& o = req.option;
+    return WireRequest{
+        WireRequestMagic, WireVersion,
+        o.K, o.T, o.r, o.sig, o.D, o.S_0, o.H, o.betaCEV, o.scale,
+        o.type, static_cast<std::int32_t>(req.style), static_cast<std::int32_t>(req.scheme),
+        req.NT, req.NSIM, req.seed
+    };
+}
+
+// Returns false for frames with the wrong magic/version or out-of-range enums
+inline bool DecodeRequest(const WireRequest& w, PricingRequest& req) {
+    if (w.magic != WireRequestMagic || w.version != WireVersion) return false;
+    if (w.style < 0 || w.style > 1 || w.scheme < 0 || w.scheme > 2) return false;
+    req.option = OptionData{
+        .K = w.K, .T = w.T, .r = w.r, .sig = w.sig, .D = w.D, .S_0 = w.S_0,
+        .type = w.type, .H = w.H, .betaCEV = w.betaCEV, .scale = w.scale
+    };
+    req.style = static_cast<PayoffStyle>(w.style);
+    req.scheme = static_cast<SchemeType>(w.scheme);
+    req.NT = w.NT;
+    req.NSIM = w.NSIM;
+    req.seed = w.seed;
+    return true;
+}
+
+inline WireResponse EncodeResponse(const PricingResult& res) {
+    return WireResponse{
+        WireResponseMagic, static_cast<std::int32_t>(res.status),
+        res.price, res.stdDev, res.stdErr, res.paths
+    };
+}
+
+inline PricingResult DecodeResponse(const WireResponse& w) {
+    PricingResult res;
+    if (w.magic != WireResponseMagic) {
+        res.status = PricingStatus::InternalError;
+        return res;
+    }
+    res.status = static_cast<PricingStatus>(w.status);
+    res.price = w.price;
+    res.stdDev = w.stdDev;
+    res.stdErr = w.stdErr;
+    res.paths = w.paths;
+    return res;
+}
+
+#endif
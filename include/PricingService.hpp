@@ -0,0 +1,109 @@
+#ifndef PricingService_HPP
+#define PricingService_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MTEngRandNumGen.hpp"
+#include "PricingProtocol.hpp"
+#include "ResultCache.hpp"
+
+// Resident pricing service listening on a Unix domain socket.
+//
+// Worker threads and their random number generators live for the lifetime of
+// the service. Queued requests on the same underlying (see UnderlyingKey) are
+// coalesced into one shared-path simulation. Each connection may pipeline
+// requests; responses come back in request order.
+class PricingService {
+public:
+    struct Config {
+        std::string socketPath;
+        unsigned workers{0};                                  // 0 = hardware concurrency
+        std::chrono::microseconds coalesceWindow{200};        // wait for batch mates in a burst
+        size_t maxBatch{64};
+        std::shared_ptr<ResultCache> cache;                   // optional result cache
+        std::int64_t maxPaths{MaxRequestPaths};               // larger requests are rejected
+    };
+
+    explicit PricingService(Config config);
+    ~PricingService();
+
+    PricingService(const PricingService&) = delete;
+    PricingService& operator=(const PricingService&) = delete;
+
+    // Binds the socket and starts the workers; throws std::runtime_error
+    void Start();
+    void Stop();
+
+    // In-process entry point, also used by the socket front end
+    std::future<PricingResult> Submit(const PricingRequest& request);
+
+    // Number of simulations run so far (one per coalesced batch)
+    std::uint64_t SimulationsRun() const { return simulations.load(); }
+    std::uint64_t RequestsServed() const { return served.load(); }
+
+    // Open socket connections; closed ones are reaped by the acceptor
+    size_t ConnectionCount();
+
+private:
+    struct Job {
+        PricingRequest request;
+        std::promise<PricingResult> promise;
+        std::optional<CacheEntry> cached;   // partial hit found by Submit, which does the only lookup
+    };
+
+    struct Connection;
+
+    void WorkerLoop(size_t workerId);
+    void AcceptLoop();
+    void ReapConnections();
+    void ReadLoop(std::shared_ptr<Connection> conn);
+    void WriteLoop(std::shared_ptr<Connection> conn);
+
+    Config cfg;
+    int listenFd{-1};
+    std::atomic<bool> running{false};
+
+    std::mutex queueMtx;
+    std::condition_variable queueCv;
+    std::deque<Job> queue;
+
+    std::vector<std::thread> workers;
+    std::vector<std::shared_ptr<MTEngRandNumGen>> workerRng;
+    std::thread acceptor;
+
+    std::mutex connMtx;
+    std::vector<std::shared_ptr<Connection>> connections;
+
+    std::atomic<std::uint64_t> simulations{0};
+    std::atomic<std::uint64_t> served{0};
+};
+
+// Blocking client for the service socket
+class PricingClient {
+public:
+    explicit PricingClient(const std::string& socketPath);
+    ~PricingClient();
+
+    PricingClient(const PricingClient&) = delete;
+    PricingClient& operator=(const PricingClient&) = delete;
+
+    PricingResult Price(const PricingRequest& request);
+
+    // Sends all requests before reading any response so the server can batch them
+    std::vector<PricingResult> PriceAll(const std::vector<PricingRequest>& requests);
+
+private:
+    int fd{-1};
+};
+
+#endif
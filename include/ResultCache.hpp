@@ -0,0 +1,106 @@
+#ifndef ResultCache_HPP
+#define ResultCache_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MTEngRandNumGen.hpp"
+#include "PathStatistics.hpp"
+#include "PricingProtocol.hpp"
+
+// Content-addressed cache of pricing results.
+//
+// The key is a canonical hash of every input that determines the estimate
+// except the path count: OptionData, payoff style, scheme, NT and seed. An
+// entry keeps the raw accumulators, so a request for more paths than are
+// cached is served by simulating only the difference and merging.
+//
+// Entries live in an LRU in memory; with a directory configured they are also
+// written through to <dir>/<key>.mcr and read back on a memory miss. Disk
+// reads and writes happen outside the lock, so a slow disk only delays the
+// request that touches it. Memory is authoritative: when two stores of one key
+// race, the file may keep the older entry, which is still a valid estimate.
+//
+// Requests with seed 0 continue the worker's stream and are not reproducible,
+// so they are never looked up or stored.
+struct CacheEntry {
+    PathStatistics stats;
+    double discount{1.0};
+
+    PricingResult Result() const {
+        PricingResult res;
+        const auto [sd, se] = stats.StandardDeviationStats();
+        res.price = stats.Price(discount);
+        res.stdDev = sd;
+        res.stdErr = se;
+        res.paths = stats.count;
+        return res;
+    }
+};
+
+class ResultCache {
+public:
+    explicit ResultCache(size_t capacity = 4096, std::string persistDirectory = "");
+
+    static bool Cacheable(const PricingRequest& request) { return request.seed != 0; }
+
+    // Canonical byte encoding of the cache-relevant inputs and its FNV-1a hash
+    static std::vector<std::uint8_t> CanonicalKey(const PricingRequest& request);
+    static std::uint64_t Hash(const PricingRequest& request);
+
+    std::optional<CacheEntry> Lookup(const PricingRequest& request);
+    void Store(const PricingRequest& request, const CacheEntry& entry);
+    void Clear();   // memory tier only
+
+    size_t Size() const;
+    std::uint64_t Hits() const;
+    std::uint64_t Misses() const;
+
+private:
+    struct Slot {
+        std::vector<std::uint8_t> key;
+        CacheEntry entry;
+        std::list<std::uint64_t>::iterator lruPos;
+    };
+
+    std::string FileFor(std::uint64_t hash) const;
+    std::optional<CacheEntry> LoadFromDisk(std::uint64_t hash, const std::vector<std::uint8_t>& key) const;
+    void SaveToDisk(std::uint64_t hash, const std::vector<std::uint8_t>& key, const CacheEntry& entry) const;
+    void Insert(std::uint64_t hash, std::vector<std::uint8_t> key, const CacheEntry& entry);
+
+    size_t capacity;
+    std::string directory;
+    mutable std::atomic<std::uint64_t> writeSerial{0};   // names temporary files
+    mutable std::mutex mtx;
+    std::unordered_map<std::uint64_t, Slot> slots;
+    std::list<std::uint64_t> lru;   // most recent first
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+};
+
+// Seed for the extra paths that top up an entry already holding `pathsDone`
+// paths, so the new paths use a different stream than the cached ones
+inline std::uint64_t TopUpSeed(std::uint64_t seed, std::int64_t pathsDone) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ull * static_cast<std::uint64_t>(pathsDone + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (z ^ (z >> 31)) | 1u;
+}
+
+// Prices the requests through the cache: full hits are answered directly,
+// partial hits only simulate the missing paths. Requests need not share an
+// underlying; misses are grouped by UnderlyingKey and priced per group.
+// Callers that already looked the requests up pass what they found (one
+// entry per request) in lookedUp, and the cache is then only written.
+std::vector<PricingResult> PriceBatchCached(const std::vector<PricingRequest>& batch,
+                                            std::shared_ptr<MTEngRandNumGen>& rng,
+                                            ResultCache& cache,
+                                            const std::vector<std::optional<CacheEntry>>* lookedUp = nullptr);
+
+#endif
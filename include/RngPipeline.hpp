@@ -0,0 +1,172 @@
+#ifndef RngPipeline_HPP
+#define RngPipeline_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <thread>
+#include "NumaTopology.hpp"
+
+// Pipelined random numbers: a producer thread fills fixed-size chunks of a
+// single-producer/single-consumer ring while the consumer steps paths on the
+// chunks already filled. Slots are handed over by pointer, so the consumer
+// reads the normals where the producer wrote them. A full ring stalls the
+// producer and an empty one the consumer (back-pressure); both then block on
+// an atomic wait rather than spinning, so an idle side leaves its core (or
+// SMT sibling) to the other. Indices are published once per chunk, which
+// keeps the synchronisation cost independent of the chunk size.
+
+struct RngPipelineConfig {
+    size_t chunkBytes{64 * 1024};   // per ring slot, rounded to whole block steps
+    size_t slots{8};                // ring depth; the producer runs at most this far ahead
+    int producerCpu{-1};            // pin the producer here, e.g. an SMT sibling (-1 = unpinned)
+};
+
+struct RngPipelineStats {
+    std::uint64_t chunks{0};
+    std::uint64_t producerStalls{0};   // ring full: generation ahead of stepping
+    std::uint64_t consumerStalls{0};   // ring empty: stepping waited for normals
+};
+
+template <typename T>
+class SpscChunkRing {
+public:
+    SpscChunkRing(size_t slots, size_t chunkSize)
+        : numSlots(slots > 0 ? slots : 1)
+        , chunk(chunkSize > 0 ? chunkSize : 1)
+        , storage(new (std::align_val_t{64}) T[numSlots * chunk])
+    {}
+
+    SpscChunkRing(const SpscChunkRing&) = delete;
+    SpscChunkRing& operator=(const SpscChunkRing&) = delete;
+
+    size_t ChunkSize() const { return chunk; }
+    size_t Slots() const { return numSlots; }
+
+    // Producer: the next free slot, waiting while the ring is full; nullptr
+    // once the consumer has closed the ring
+    T* AcquireWrite() {
+        if (closed.load(std::memory_order_acquire)) return nullptr;
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (!Await([&] { return t - head.load(std::memory_order_acquire) < numSlots; }, producerStalls)) {
+            return nullptr;
+        }
+        return Slot(t);
+    }
+
+    void CommitWrite() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        Signal();
+    }
+
+    // Consumer: the oldest filled slot, waiting while the ring is empty.
+    // Rethrows the producer's exception; nullptr if closed and drained.
+    T* AcquireRead() {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (!Await([&] { return tail.load(std::memory_order_acquire) != h; }, consumerStalls)) {
+            if (tail.load(std::memory_order_acquire) != h) return Slot(h);
+            if (failure) std::rethrow_exception(failure);
+            return nullptr;
+        }
+        return Slot(h);
+    }
+
+    void ReleaseRead() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        Signal();
+    }
+
+    // Either side: wakes the other and makes its waits fail
+    void Close() {
+        closed.store(true, std::memory_order_release);
+        Signal();
+    }
+
+    // Producer: closes the ring; the consumer rethrows e once drained
+    void Fail(std::exception_ptr e) {
+        failure = std::move(e);
+        Close();
+    }
+
+    // Times each side found the ring full (producer) or empty (consumer)
+    std::uint64_t ProducerStalls() const { return producerStalls.load(std::memory_order_relaxed); }
+    std::uint64_t ConsumerStalls() const { return consumerStalls.load(std::memory_order_relaxed); }
+
+private:
+    struct AlignedDelete {
+        void operator()(T* p) const { ::operator delete[](p, std::align_val_t{64}); }
+    };
+
+    T* Slot(size_t index) { return storage.get() + (index % numSlots) * chunk; }
+
+    // True once ready() holds, false if the ring was closed first
+    template <typename Ready>
+    bool Await(Ready ready, std::atomic<std::uint64_t>& stalls) {
+        if (ready()) return true;
+        stalls.fetch_add(1, std::memory_order_relaxed);
+        for (int spin = 0; spin < 128; ++spin) {
+            if (ready()) return true;
+        }
+        while (true) {
+            const std::uint32_t seen = events.load(std::memory_order_acquire);
+            if (ready()) return true;
+            if (closed.load(std::memory_order_acquire)) return false;
+            events.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    void Signal() {
+        events.fetch_add(1, std::memory_order_release);
+        events.notify_all();
+    }
+
+    const size_t numSlots;
+    const size_t chunk;
+    std::unique_ptr<T[], AlignedDelete> storage;
+
+    alignas(64) std::atomic<size_t> head{0};   // next slot to read, written by the consumer
+    alignas(64) std::atomic<size_t> tail{0};   // next slot to write, written by the producer
+    alignas(64) std::atomic<std::uint32_t> events{0};
+    std::atomic<bool> closed{false};
+    std::exception_ptr failure;                 // set before closed
+    std::atomic<std::uint64_t> producerStalls{0};
+    std::atomic<std::uint64_t> consumerStalls{0};
+};
+
+// Runs a producer on its own thread for the lifetime of the object. The
+// destructor closes the ring, so a consumer that stops early (or throws)
+// releases a producer blocked on a full ring, and then joins it.
+template <typename T>
+class RingProducer {
+public:
+    template <typename Produce>
+    RingProducer(SpscChunkRing<T>& ringRef, int cpu, Produce produce)
+        : ring(ringRef)
+        , thread([this, cpu, produce]() mutable {
+            if (cpu >= 0) PinCurrentThread(cpu);
+            try {
+                produce(ring);
+            }
+            catch (...) {
+                ring.Fail(std::current_exception());
+            }
+        })
+    {}
+
+    ~RingProducer() {
+        ring.Close();
+        thread.join();
+    }
+
+    RingProducer(const RingProducer&) = delete;
+    RingProducer& operator=(const RingProducer&) = delete;
+
+private:
+    SpscChunkRing<T>& ring;
+    std::thread thread;
+};
+
+#endif
@@ -4,10 +4,28 @@
 #include <concepts>
 #include <memory>
 #include <functional>
+#include <optional>
+#include "JumpDiffusion.hpp"
+#include "LocalVolSurface.hpp"
 #include "OptionData.hpp"
 
 using InputFunction = std::function<double(const double, const double)>;
 
+// Closed form of dS = mu S dt + sig S^beta dW (GBM for beta = 1). When an
+// SDE carries it, schemes can step blocks of paths without std::function calls.
+struct CEVCoefficients {
+    double mu;
+    double sig;
+    double beta;
+};
+
+// dS = mu S dt + sigma(t, S) S dW with sigma interpolated on a grid surface;
+// schemes step blocks through the surface's slice lookup when an SDE carries it
+struct LocalVolCoefficients {
+    double mu;
+    std::shared_ptr<const LocalVolSurface> surface;
+};
+
 class SDEGeneral {
 public:
     alignas(64) InputFunction m_drift;
@@ -15,6 +33,9 @@ public:
     alignas(64) InputFunction m_driftCorrected;
     alignas(64) InputFunction m_diffusionDerivative;
     std::shared_ptr<OptionData> data;
+    std::optional<CEVCoefficients> closedForm;  // must describe m_drift/m_diffusion exactly
+    std::optional<LocalVolCoefficients> localVol; // likewise
+    std::optional<JumpCoefficients> jumps;        // compound Poisson jumps on top; drift already compensated
 
     SDEGeneral(const std::tuple<InputFunction, InputFunction, InputFunction, InputFunction>& sdePieces, 
                const OptionData& optionData)
@@ -0,0 +1,101 @@
+#ifndef ShardRun_HPP
+#define ShardRun_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "PathStatistics.hpp"
+#include "Precision.hpp"
+#include "PricingProtocol.hpp"
+#include "SimulationControl.hpp"
+
+// Multi-process runs of one pricing request.
+//
+// The request's paths are cut into blocks of pathsPerBlock; block b always
+// simulates on substream b of the request seed, exactly as in JobScheduler.
+// Shard i of n owns the contiguous block range BlockRange(), so shards draw
+// disjoint substreams and the merged estimate is the same for any n. It also
+// equals a JobScheduler run with equal seed, pathsPerBlock, kernelBlockSize
+// and precision; both default to path-by-path stepping (kernelBlockSize 0).
+// Block mode and path mode draw different normals, so the kernel block size
+// and precision are part of the run and recorded in the state file.
+//
+// A shard periodically writes its state to a file: the accumulators of the
+// blocks done and the next block. Since every block reseeds its generator
+// from (seed, block), that block index is the whole generator state, and a
+// restarted shard resumes from the file bit for bit. The final write is the
+// shard's result file; MergeShardFiles combines them.
+
+struct ShardSpec {
+    std::uint64_t index{0};
+    std::uint64_t count{1};
+
+    // "i/n" with 0 <= i < n; throws std::runtime_error otherwise
+    static ShardSpec Parse(const std::string& text);
+
+    // Blocks [first, last) of numBlocks owned by this shard
+    std::pair<std::int64_t, std::int64_t> BlockRange(std::int64_t numBlocks) const;
+};
+
+// Checkpoint and result file contents; the two share one format
+struct ShardState {
+    PricingRequest request;
+    ShardSpec shard;
+    std::int64_t pathsPerBlock{0};
+    std::uint64_t kernelBlockSize{0};
+    Precision precision{Precision::Double};
+    std::int64_t firstBlock{0};
+    std::int64_t lastBlock{0};
+    std::int64_t nextBlock{0};     // first block not yet in stats
+    PathStatistics stats;          // undiscounted payoff accumulators
+    double discount{1.0};
+
+    bool Complete() const { return nextBlock >= lastBlock; }
+};
+
+// Written to a temporary and renamed, so a crash never leaves a torn file.
+// Both throw std::runtime_error on I/O errors or malformed files; Load
+// returns nullopt if the file does not exist.
+void SaveShardState(const std::string& path, const ShardState& state);
+std::optional<ShardState> LoadShardState(const std::string& path);
+
+struct ShardRunConfig {
+    std::int64_t pathsPerBlock{65536};
+    size_t kernelBlockSize{0};            // MCCentralHub::SetBlockSize per block
+    Precision precision{Precision::Double};
+    double checkpointSeconds{30.0};       // 0 = after every block
+    // Checked between blocks only, so a stopped shard has whole blocks and
+    // resumes exactly; its file is written before returning
+    std::shared_ptr<SimulationControl> control;
+    std::function<void(const ShardState&)> onCheckpoint;   // after each write
+};
+
+// Runs (or resumes, if statePath holds a checkpoint of the same run) shard
+// `shard` of the request and leaves its state in statePath. The request needs
+// a non-zero seed so every shard draws from the same substream family; a
+// checkpoint of a different request, shard, block size, kernel block size or
+// precision is an error.
+ShardState RunShard(const PricingRequest& request, const ShardSpec& shard,
+                    const std::string& statePath, const ShardRunConfig& config = {});
+
+struct ShardMerge {
+    PricingResult result;     // status Cancelled unless every shard is complete
+    PathStatistics stats;
+    std::vector<std::uint64_t> missing;      // shard indices without a file, at most MaxListedMissing
+    std::uint64_t missingCount{0};           // all shards without a file
+    std::vector<std::uint64_t> incomplete;   // shards with a partial checkpoint
+};
+
+constexpr size_t MaxListedMissing = 1024;
+
+// Combines the states of one sharded run; throws if they belong to different
+// runs or if a shard appears twice. Memory is bounded by the number of states,
+// not by the shard count the files claim.
+ShardMerge MergeShardStates(const std::vector<ShardState>& states);
+ShardMerge MergeShardFiles(const std::vector<std::string>& paths);
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef SimulationControl_HPP
+#define SimulationControl_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "PathStatistics.hpp"
+
+struct ProgressSample {
+    std::int64_t paths{0};
+    std::int64_t target{0};         // 0 if unknown
+    double pathsPerSecond{0.0};     // since the previous sample
+    double estimate{0.0};           // discounted running price
+    double stdErr{0.0};
+    double elapsed{0.0};            // seconds since the control was created
+    bool stopped{false};            // cancelled or past the deadline
+};
+
+// Progress and stop channel shared between a running simulation and its
+// observers. Hubs publish path counts and accumulator deltas at block
+// boundaries and check ShouldStop() there; nothing on the per-path hot path
+// touches it. One control may be shared by several concurrent hubs (e.g. the
+// blocks of one scheduler job).
+class SimulationControl {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SimulationControl() : start(Clock::now()) {}
+
+    void SetTarget(std::int64_t totalPaths) { target = totalPaths; }
+    void SetDiscount(double df) { discount = df; }
+
+    // Cooperative: running hubs stop at their next block boundary
+    void Cancel() { cancelled = true; }
+    bool Cancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    void SetDeadline(Clock::time_point when) {
+        deadlineNs = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+    }
+    void SetTimeout(Clock::duration budget) { SetDeadline(Clock::now() + budget); }
+
+    bool DeadlinePassed() const {
+        const std::int64_t d = deadlineNs.load(std::memory_order_relaxed);
+        return d != 0 && std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             Clock::now().time_since_epoch()).count() >= d;
+    }
+
+    bool ShouldStop() const { return Cancelled() || DeadlinePassed(); }
+
+    void Record(std::int64_t newPaths, const PathStatistics& delta) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stats.Merge(delta);
+        }
+        paths.fetch_add(newPaths, std::memory_order_relaxed);
+    }
+
+    std::int64_t Paths() const { return paths.load(std::memory_order_relaxed); }
+
+    PathStatistics Statistics() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return stats;
+    }
+
+    // pathsPerSecond is left at zero; ProgressReporter fills it in
+    ProgressSample Sample() const {
+        ProgressSample s;
+        const PathStatistics snapshot = Statistics();
+        s.paths = Paths();
+        s.target = target.load();
+        s.estimate = snapshot.Price(discount.load());
+        s.stdErr = discount.load() * std::get<1>(snapshot.StandardDeviationStats());
+        s.elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        s.stopped = ShouldStop();
+        return s;
+    }
+
+private:
+    const Clock::time_point start;
+    std::atomic<bool> cancelled{false};
+    std::atomic<std::int64_t> deadlineNs{0};   // steady_clock ns, 0 = none
+    std::atomic<std::int64_t> paths{0};
+    std::atomic<std::int64_t> target{0};
+    std::atomic<double> discount{1.0};
+    mutable std::mutex mtx;
+    PathStatistics stats;
+};
+
+// Samples a SimulationControl on its own thread every interval and hands the
+// sample to a callback; a final sample is delivered when the reporter stops.
+class ProgressReporter {
+public:
+    using Callback = std::function<void(const ProgressSample&)>;
+
+    ProgressReporter(std::shared_ptr<SimulationControl> ctl, std::chrono::milliseconds interval, Callback cb)
+        : control(std::move(ctl))
+        , period(interval)
+        , callback(std::move(cb))
+        , worker([this] { Run(); })
+    {}
+
+    ~ProgressReporter() { Stop(); }
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (stopping) return;
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+private:
+    void Run() {
+        std::int64_t lastPaths = 0;
+        double lastTime = 0.0;
+        bool done = false;
+        while (!done) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                done = cv.wait_for(lock, period, [this] { return stopping; });
+            }
+            ProgressSample s = control->Sample();
+            if (s.elapsed > lastTime) {
+                s.pathsPerSecond = static_cast<double>(s.paths - lastPaths) / (s.elapsed - lastTime);
+            }
+            lastPaths = s.paths;
+            lastTime = s.elapsed;
+            if (callback) callback(s);
+        }
+    }
+
+    std::shared_ptr<SimulationControl> control;
+    std::chrono::milliseconds period;
+    Callback callback;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping{false};
+    std::thread worker;   // last: started once everything above is initialised
+};
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef StratifiedSampling_HPP
+#define StratifiedSampling_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <numeric>
+#include <vector>
+#include "PathStatistics.hpp"
+
+// Stratified sampling of the terminal Brownian value W_T. The real line is
+// cut into M equiprobable strata; a path in stratum i draws
+// W_T = sqrt(T) * InverseNormalCDF((i + U) / M) and fills its steps with a
+// Brownian bridge pinned at W_T, so each path keeps the law of Brownian
+// motion conditioned on its stratum. M = NumSim / 2 with proportional
+// allocation only approximates a Latin hypercube of W_T: a true one has a
+// single path per stratum, which leaves no within-stratum variance for the
+// standard error, so two paths per stratum are kept instead.
+
+enum class StrataAllocation {
+    Proportional,   // n_i = N / M
+    Optimal         // Neyman: n_i proportional to the stratum SD, estimated by
+                    // a pilot whose paths count toward n_i
+};
+
+struct StratificationConfig {
+    size_t strata{64};           // capped at NumSim / 2: two paths per stratum at least
+    StrataAllocation allocation{StrataAllocation::Proportional};
+    double pilotFraction{0.1};   // optimal allocation: share of paths for the pilot
+};
+
+// Per-stratum accumulators of one stratified run; strata are equiprobable
+struct StratifiedEstimate {
+    std::vector<PathStatistics> strata;
+
+    std::int64_t Paths() const {
+        std::int64_t n = 0;
+        for (const auto& s : strata) n += s.count;
+        return n;
+    }
+
+    // sum_i p_i * mean_i; unlike the pricer's pooled mean this stays unbiased
+    // when strata are not sampled in proportion to their probability
+    double Price(double discountFactor) const {
+        if (strata.empty()) return 0.0;
+        double mean = 0.0;
+        for (const auto& s : strata) mean += s.Price(1.0);
+        return discountFactor * mean / static_cast<double>(strata.size());
+    }
+
+    // sqrt(sum_i p_i^2 var_i / n_i); needs two paths in every stratum, which
+    // MCCentralHub guarantees for completed runs
+    double StdErr(double discountFactor) const {
+        if (strata.empty()) return 0.0;
+        double var = 0.0;
+        for (const auto& s : strata) {
+            const double se = std::get<1>(s.StandardDeviationStats());
+            var += se * se;
+        }
+        return discountFactor * std::sqrt(var) / static_cast<double>(strata.size());
+    }
+};
+
+// Acklam's rational approximation refined by one Halley step (~1e-15)
+inline double InverseNormalCDF(double p) {
+    static constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                   1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                   6.680131188771972e+01, -1.328068155288572e+01};
+    static constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                   -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                   3.754408661907416e+00};
+    constexpr double pLow = 0.02425;
+
+    double x;
+    if (p < pLow) {
+        const double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+          / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    else if (p > 1.0 - pLow) {
+        const double q = std::sqrt(-2.0 * std::log1p(-p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+          / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    else {
+        const double q = p - 0.5;
+        const double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+          / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    const double u = e * std::sqrt(2.0 * std::numbers::pi) * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+// Splits total paths over the strata in proportion to weights (largest
+// remainder), after giving every stratum minPerStratum. Zero weights fall
+// back to an even split.
+inline std::vector<std::int64_t> AllocatePaths(std::int64_t total, const std::vector<double>& weights,
+                                               std::int64_t minPerStratum) {
+    const size_t M = weights.size();
+    std::vector<std::int64_t> counts(M, minPerStratum);
+    std::int64_t left = total - minPerStratum * static_cast<std::int64_t>(M);
+    if (M == 0 || left <= 0) return counts;
+
+    double wsum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    std::vector<double> w = weights;
+    if (!(wsum > 0.0)) {
+        std::fill(w.begin(), w.end(), 1.0);
+        wsum = static_cast<double>(M);
+    }
+
+    std::vector<double> frac(M);
+    std::int64_t given = 0;
+    for (size_t i = 0; i < M; ++i) {
+        const double share = static_cast<double>(left) * w[i] / wsum;
+        const auto whole = static_cast<std::int64_t>(std::floor(share));
+        counts[i] += whole;
+        given += whole;
+        frac[i] = share - static_cast<double>(whole);
+    }
+    std::vector<size_t> order(M);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return frac[x] > frac[y]; });
+    for (size_t k = 0; given < left; k = (k + 1) % M, ++given) {
+        ++counts[order[k]];
+    }
+    return counts;
+}
+
+// Main-run counts after a pilot of pilotCounts paths, so that pilot plus main
+// run follow the Neyman allocation of total paths for the stratum SDs. Strata
+// the pilot already oversampled get nothing more and the remaining budget is
+// shared in proportion to the other strata's shortfall, which is exactly
+// Neyman whenever the pilot undershoots every stratum.
+inline std::vector<std::int64_t> NeymanTopUp(std::int64_t total, const std::vector<std::int64_t>& pilotCounts,
+                                             const std::vector<double>& sds) {
+    const std::int64_t pilot = std::accumulate(pilotCounts.begin(), pilotCounts.end(), std::int64_t{0});
+    const std::vector<std::int64_t> target = AllocatePaths(total, sds, 2);
+    std::vector<double> shortfall(target.size());
+    for (size_t i = 0; i < target.size(); ++i) {
+        shortfall[i] = static_cast<double>(std::max<std::int64_t>(target[i] - pilotCounts[i], 0));
+    }
+    return AllocatePaths(total - pilot, shortfall, 0);
+}
+
+// Unit normals z[j * stride] for the steps of times[0..N] such that the
+// Brownian path sum_j sqrt(dt_j) z_j ends at WT; intermediate points are
+// drawn from the bridge between the previous point and WT
+template <typename NormalGen>
+void BrownianBridgeNormals(const std::vector<double>& times, double WT, NormalGen&& normal,
+                           double* z, size_t stride) {
+    const size_t N = times.size() - 1;
+    const double T = times.back();
+    double W = 0.0;
+    for (size_t j = 0; j < N; ++j) {
+        const double dt = times[j + 1] - times[j];
+        double next = WT;
+        if (j + 1 < N) {
+            const double rem = T - times[j];
+            next = W + dt / rem * (WT - W) + std::sqrt(dt * (T - times[j + 1]) / rem) * normal();
+        }
+        z[j * stride] = (next - W) / std::sqrt(dt);
+        W = next;
+    }
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef StreamingPricer_HPP
+#define StreamingPricer_HPP
+
+#include <cstddef>
+#include "Pricer.hpp"
+
+// Pricers that can consume a block of paths step by step. The hub hands over
+// the n states at grid index j after each step instead of storing paths; such
+// pricers still accept whole paths through GeneratePath.
+class StreamingPricer : public Pricer {
+public:
+    using Pricer::Pricer;
+
+    virtual void BeginBlock(size_t pathSize, size_t n) = 0;
+    virtual void Observe(size_t j, const double* x, size_t n) = 0;
+    virtual void Observe(size_t j, const float* x, size_t n) = 0;
+    virtual void EndBlock(size_t n) = 0;   // adds the block's payoffs
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef TimeGrid_HPP
+#define TimeGrid_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+// Simulation time grid: strictly increasing time points starting at 0, plus
+// the indices of the points that are observation (fixing/monitoring) dates.
+// An empty observation list means "no explicit schedule" and pricers fall
+// back to their default monitoring.
+class TimeGrid {
+private:
+    std::vector<double> times;
+    std::vector<size_t> observations;
+
+public:
+    TimeGrid(std::vector<double> timePoints, std::vector<size_t> observationIndices = {})
+        : times(std::move(timePoints))
+        , observations(std::move(observationIndices))
+    {
+        if (times.size() < 2) {
+            throw std::runtime_error("Time grid needs at least two points");
+        }
+        if (times[0] != 0.0) {
+            throw std::runtime_error("Time grid must start at t = 0");
+        }
+        for (size_t i = 1; i < times.size(); ++i) {
+            if (!(times[i] > times[i - 1])) {
+                throw std::runtime_error("Time grid must be strictly increasing");
+            }
+        }
+        std::sort(observations.begin(), observations.end());
+        observations.erase(std::unique(observations.begin(), observations.end()), observations.end());
+        if (!observations.empty() && observations.back() >= times.size()) {
+            throw std::runtime_error("Observation index outside the time grid");
+        }
+    }
+
+    // NT equal steps on [0, T], no explicit observation schedule
+    static TimeGrid Uniform(double T, int NT) {
+        if (NT <= 0) {
+            throw std::runtime_error("Number of time steps must be positive");
+        }
+        if (T <= 0) {
+            throw std::runtime_error("Time period T must be positive");
+        }
+        const double m = T / static_cast<double>(NT);
+        std::vector<double> t(static_cast<size_t>(NT) + 1);
+        t[0] = 0.0;
+        for (size_t i = 1; i < t.size(); ++i) {
+            t[i] = t[i - 1] + m;
+        }
+        return TimeGrid(std::move(t));
+    }
+
+    // Grid through 0, every fixing date and T. Each interval between event
+    // dates is split into equal sub-steps no longer than maxStep (0 = no
+    // refinement). The fixing dates become the observation indices.
+    static TimeGrid FromFixings(std::vector<double> fixings, double T, double maxStep = 0.0) {
+        if (T <= 0) {
+            throw std::runtime_error("Time period T must be positive");
+        }
+        if (maxStep < 0) {
+            throw std::runtime_error("Maximum step must be non-negative");
+        }
+        const double eps = 1e-12 * T;
+        for (double f : fixings) {
+            if (f < -eps || f > T + eps) {
+                throw std::runtime_error("Fixing date outside [0, T]");
+            }
+        }
+        std::sort(fixings.begin(), fixings.end());
+
+        std::vector<double> events{0.0};
+        for (double f : fixings) {
+            if (f - events.back() > eps) {
+                events.push_back(f);
+            }
+        }
+        if (T - events.back() > eps) {
+            events.push_back(T);
+        }
+        else {
+            events.back() = T;
+        }
+
+        std::vector<double> t{0.0};
+        std::vector<size_t> obs;
+        if (!fixings.empty() && fixings.front() <= eps) {
+            obs.push_back(0);
+        }
+        size_t nextFixing = 0;
+        for (size_t e = 1; e < events.size(); ++e) {
+            const double len = events[e] - events[e - 1];
+            const size_t nSub = maxStep > 0.0
+                ? std::max<size_t>(1, static_cast<size_t>(std::ceil(len / maxStep - 1e-9)))
+                : 1;
+            for (size_t k = 1; k < nSub; ++k) {
+                t.push_back(events[e - 1] + len * static_cast<double>(k) / static_cast<double>(nSub));
+            }
+            t.push_back(events[e]);
+
+            while (nextFixing < fixings.size() && fixings[nextFixing] <= events[e] + eps) {
+                if (fixings[nextFixing] > eps) {
+                    obs.push_back(t.size() - 1);
+                }
+                ++nextFixing;
+            }
+        }
+        return TimeGrid(std::move(t), std::move(obs));
+    }
+
+    const std::vector<double>& Times() const { return times; }
+    const std::vector<size_t>& ObservationIndices() const { return observations; }
+    int NumSteps() const { return static_cast<int>(times.size()) - 1; }
+    double Maturity() const { return times.back(); }
+
+    // dt for each step, steps[j] = times[j + 1] - times[j]
+    std::vector<double> Steps() const {
+        std::vector<double> dt(times.size() - 1);
+        for (size_t i = 0; i < dt.size(); ++i) {
+            dt[i] = times[i + 1] - times[i];
+        }
+        return dt;
+    }
+};
+
+#endif
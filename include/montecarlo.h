@@ -0,0 +1,114 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+/*
+ * C interface of libmontecarlo: in-process batch pricing of European and
+ * Asian options on reusable engines.
+ *
+ * An engine owns a worker pool whose threads, generators, model objects and
+ * per-option/per-block buffers stay alive between calls. The buffers only
+ * grow when a batch has more options or paths than any before it, so once
+ * an engine has run a batch of some shape, pricing batches no larger does
+ * not allocate. mc_price_batch reads the caller's option and run parameter
+ * arrays and writes the caller's result array in place; nothing is returned
+ * that the caller has to free. Functions never throw; they return
+ * one of the MC_ERR_* codes and leave per-option problems in
+ * mc_result.status.
+ *
+ * All structs are plain C data with fixed-width fields. New fields are only
+ * ever added through a new API version.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define MC_API __attribute__((visibility("default")))
+#else
+#define MC_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MC_API_VERSION 1
+
+/* Return codes of the API functions */
+#define MC_OK 0
+#define MC_ERR_INVALID_ARGUMENT (-1)
+#define MC_ERR_INTERNAL (-2)
+
+/* mc_result.status, same values as PricingStatus */
+#define MC_STATUS_OK 0
+#define MC_STATUS_BAD_REQUEST 1
+#define MC_STATUS_INTERNAL_ERROR 2
+#define MC_STATUS_CANCELLED 3
+
+#define MC_STYLE_EUROPEAN 0
+#define MC_STYLE_ASIAN 1
+
+#define MC_SCHEME_EULER 0
+#define MC_SCHEME_PREDICTOR_CORRECTOR 1
+#define MC_SCHEME_LOG_EULER 2         /* exact for GBM on any grid */
+
+typedef struct mc_option_spec {
+    double K;
+    double T;
+    double r;
+    double sig;
+    double D;          /* dividend yield */
+    double S_0;
+    double betaCEV;    /* 1 = GBM */
+    int32_t type;      /* 1 = call, -1 = put */
+    int32_t style;     /* MC_STYLE_* */
+} mc_option_spec;
+
+typedef struct mc_run_params {
+    int32_t scheme;    /* MC_SCHEME_* */
+    int32_t NT;        /* time steps */
+    int64_t NSIM;      /* paths */
+    uint64_t seed;     /* 0 = fresh random seed per option */
+} mc_run_params;
+
+typedef struct mc_result {
+    int32_t status;    /* MC_STATUS_* */
+    int32_t reserved;
+    double price;
+    double stdDev;
+    double stdErr;
+    int64_t paths;     /* paths used */
+} mc_result;
+
+typedef struct mc_engine_config {
+    uint32_t workers;          /* 0 = hardware concurrency */
+    uint32_t pin_workers;      /* nonzero: pin workers across NUMA nodes */
+    int64_t paths_per_block;   /* 0 = default (4096) */
+} mc_engine_config;
+
+typedef struct mc_engine mc_engine;
+
+MC_API uint32_t mc_api_version(void);
+
+/* config may be NULL for defaults */
+MC_API int mc_engine_create(const mc_engine_config* config, mc_engine** engine);
+MC_API void mc_engine_destroy(mc_engine* engine);
+
+/*
+ * Prices n options concurrently on the engine's pool and blocks until all are
+ * done. params holds either one entry shared by every option (n_params == 1)
+ * or one entry per option (n_params == n). results must hold n entries.
+ * Calls on the same engine from several threads are allowed and run one
+ * after another; use one engine per thread to price batches concurrently.
+ */
+MC_API int mc_price_batch(mc_engine* engine, const mc_option_spec* options, size_t n,
+                          const mc_run_params* params, size_t n_params, mc_result* results);
+
+/* Static string for an MC_STATUS_* value */
+MC_API const char* mc_status_string(int32_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,23 +1,67 @@
 #include <random>
 #include <memory>
 #include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <optional>
+#include <string>
 #include <tuple>
+#include "AutoTune.hpp"
 #include "EuropeanOptionPricer.hpp"
 #include "AsianOptionPricer.hpp"
 #include "FDMEuler.hpp"
 #include "FDMPredictCorrect.hpp"
 #include "FDMType.hpp"
+#include "JobScheduler.hpp"
 #include "MCCentralHub.hpp"
 #include "MTEngRandNumGen.hpp"
 #include "OptionData.hpp"
+#include "PerfCounters.hpp"
 #include "Pricer.hpp"
 #include "RandNumGen.hpp"
 #include "SDEGeneral.hpp"
+#include "SimulationControl.hpp"
 #include "StopWatch.hpp"
 
-int main() {
+// Usage: monte_carlo [--nt N] [--nsim N] [--autotune] [--retune] [--tune-profile file] [--counters]
+//   --autotune      run with the host's tuned block size, RNG batch, kernel and
+//                   thread count, calibrating first if no profile exists yet
+//   --retune        calibrate again even if a profile exists (implies --autotune)
+//   --tune-profile  profile file (default DefaultTuneProfilePath())
+//   --counters      report hardware counters per simulation phase
+int main(int argc, char* argv[]) {
     std::cout << "1 factor MC with explicit Euler or Predictor-Corrector method\n";
+
+    int NT = 1000;
+    int NSIM = 50000;
+    bool autotune = false;
+    bool retune = false;
+    bool countersOn = false;
+    std::string tuneProfilePath = DefaultTuneProfilePath();
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--nt" && hasValue) NT = std::stoi(argv[++i]);
+        else if (arg == "--nsim" && hasValue) NSIM = std::stoi(argv[++i]);
+        else if (arg == "--autotune") autotune = true;
+        else if (arg == "--retune") autotune = retune = true;
+        else if (arg == "--tune-profile" && hasValue) tuneProfilePath = argv[++i];
+        else if (arg == "--counters") countersOn = true;
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--nt N] [--nsim N] [--autotune] [--retune] [--tune-profile file] [--counters]\n";
+            return 1;
+        }
+    }
+
+    std::optional<TuneProfile> tuning;
+    if (autotune) {
+        if (retune) std::remove(tuneProfilePath.c_str());
+        bool tuned = false;
+        tuning = LoadOrTune(tuneProfilePath, AutoTuneOptions{}, &tuned);
+        std::cout << (tuned ? "Tuned for " : "Loaded tuning for ") << tuning->host << " ("
+                  << tuneProfilePath << "): " << tuning->Describe() << '\n';
+    }
     
     // Option parameters with all fields initialized
     OptionData myOption{
@@ -33,10 +77,6 @@ int main() {
         .scale = 1.0      // Standard scale
     };
     
-    // Simulation parameters
-    const int NT = 1000;
-    const int NSIM = 50000;
-
     // SDE functions with [[maybe_unused]] to silence warnings
     const auto drift = [=]([[maybe_unused]] double t, double S) { 
         return (myOption.r - myOption.D) * S; 
@@ -88,18 +128,38 @@ int main() {
     std::cout << "NT = " << NT << ", NSIM = " << NSIM << ":\n";
     StopWatch sw;
 
+    // Runs a hub with a progress line every 250ms
+    auto simulateWithProgress = [&](auto& hub) {
+        auto progress = std::make_shared<SimulationControl>();
+        progress->SetTarget(NSIM);
+        progress->SetDiscount(discount());
+        hub.AttachControl(progress);
+        ProgressReporter reporter(progress, std::chrono::milliseconds(250), [](const ProgressSample& p) {
+            std::cout << "  " << p.paths << "/" << p.target << " paths, " << p.pathsPerSecond
+                      << " paths/s, estimate " << p.estimate << " +/- " << p.stdErr << '\n';
+        });
+        hub.BeginSimulation();
+    };
+
     // European Put
     sw.StartStopWatch();
     auto euroPut = std::make_tuple(sde, pricerEuroPut, fdm, randMersenneTwister);
     MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> centralHubEuroPut(euroPut, NSIM, NT);
-    centralHubEuroPut.BeginSimulation();
+    if (tuning) tuning->Apply(centralHubEuroPut);
+    std::shared_ptr<PerfProfile> counters;
+    if (countersOn) {
+        counters = std::make_shared<PerfProfile>();
+        centralHubEuroPut.AttachProfile(counters);
+    }
+    simulateWithProgress(centralHubEuroPut);
     
     std::cout << "European Put price using Mersenne Twister: " << pricerEuroPut->OptionPrice() << '\n'
               << "Std Deviation: " << std::get<0>(pricerEuroPut->StandardDeviationStats()) << '\n'
               << "Std Error: " << std::get<1>(pricerEuroPut->StandardDeviationStats()) << "\n\n";
     
     sw.StopStopWatch();
-    std::cout << "Elapsed time in seconds: " << sw.GetTime() << "\n\n";
+    std::cout << "Elapsed time in seconds: " << sw.GetTime() << '\n';
+    if (counters) std::cout << counters->Report() << '\n';
 
     // European Call
     sw.Reset();
@@ -107,7 +167,8 @@ int main() {
     
     auto euroCall = std::make_tuple(sde, pricerEuroCall, fdm, randMersenneTwister);
     MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> centralHubEuroCall(euroCall, NSIM, NT);
-    centralHubEuroCall.BeginSimulation();
+    if (tuning) tuning->Apply(centralHubEuroCall);
+    simulateWithProgress(centralHubEuroCall);
     
     std::cout << "European Call price using Mersenne Twister: " << pricerEuroCall->OptionPrice() << '\n'
               << "Std Deviation: " << std::get<0>(pricerEuroCall->StandardDeviationStats()) << '\n'
@@ -122,7 +183,8 @@ int main() {
     
     auto asianPut = std::make_tuple(sde, pricerAsianPut, fdm, randMersenneTwister);
     MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> centralHubAsianPut(asianPut, NSIM, NT);
-    centralHubAsianPut.BeginSimulation();
+    if (tuning) tuning->Apply(centralHubAsianPut);
+    simulateWithProgress(centralHubAsianPut);
     
     std::cout << "Asian Put price using Mersenne Twister: " << pricerAsianPut->OptionPrice() << '\n'
               << "Std Deviation: " << std::get<0>(pricerAsianPut->StandardDeviationStats()) << '\n'
@@ -137,7 +199,8 @@ int main() {
     
     auto asianCall = std::make_tuple(sde, pricerAsianCall, fdm, randMersenneTwister);
     MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> centralHubAsianCall(asianCall, NSIM, NT);
-    centralHubAsianCall.BeginSimulation();
+    if (tuning) tuning->Apply(centralHubAsianCall);
+    simulateWithProgress(centralHubAsianCall);
     
     std::cout << "Asian Call price using Mersenne Twister: " << pricerAsianCall->OptionPrice() << '\n'
               << "Std Deviation: " << std::get<0>(pricerAsianCall->StandardDeviationStats()) << '\n'
@@ -146,5 +209,40 @@ int main() {
     sw.StopStopWatch();
     std::cout << "Elapsed time in seconds: " << sw.GetTime() << "\n\n";
 
+    // The same four options as one book on the work-stealing job scheduler
+    sw.Reset();
+    sw.StartStopWatch();
+
+    JobScheduler::Config schedulerConfig;
+    if (tuning) {
+        schedulerConfig = tuning->SchedulerConfig();
+    }
+    else {
+        schedulerConfig.kernelBlockSize = 256;
+    }
+    schedulerConfig.pinWorkers = true;
+    if (countersOn) schedulerConfig.profile = std::make_shared<PerfProfile>();
+    JobScheduler scheduler(schedulerConfig);
+    std::cout << scheduler.PlacementReport();
+    const char* names[] = {"European Put", "European Call", "Asian Put", "Asian Call"};
+    std::vector<std::future<JobResult>> book;
+    for (PayoffStyle style : {PayoffStyle::European, PayoffStyle::Asian}) {
+        for (int type : {-1, 1}) {
+            PricingRequest request{myOption, style, SchemeType::PredictorCorrector, NT, NSIM, 0};
+            request.option.type = type;
+            book.push_back(scheduler.Submit(request));
+        }
+    }
+    std::cout << "Book priced on " << scheduler.NumWorkers() << " worker threads:\n";
+    for (size_t i = 0; i < book.size(); ++i) {
+        const JobResult job = book[i].get();
+        std::cout << names[i] << " price: " << job.result.price
+                  << ", Std Error: " << job.result.stdErr << '\n';
+    }
+
+    sw.StopStopWatch();
+    std::cout << "Elapsed time in seconds: " << sw.GetTime() << '\n';
+    if (schedulerConfig.profile) std::cout << schedulerConfig.profile->Report(true) << '\n';
+
     return 0;
 }
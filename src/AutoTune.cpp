@@ -0,0 +1,278 @@
+#include "AutoTune.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "NumaTopology.hpp"
+#include "PricingEngine.hpp"
+
+namespace {
+
+constexpr int TuneFileVersion = 1;
+
+// GBM European call stepped by predictor-corrector: the common case the
+// block kernels were written for
+PricingRequest CalibrationRequest(const AutoTuneOptions& options, std::int64_t paths) {
+    PricingRequest req;
+    req.option = OptionData{
+        .K = 100.0,        // Strike price
+        .T = 1.0,          // Time to maturity
+        .r = 0.05,         // Risk-free rate
+        .sig = 0.2,        // Volatility
+        .D = 0.0,          // Dividend rate
+        .S_0 = 100.0,      // Initial stock price
+        .type = 1,         // Call option
+        .H = 0.0,          // No barrier
+        .betaCEV = 1.0,    // Standard CEV parameter
+        .scale = 1.0       // Standard scale
+    };
+    req.style = PayoffStyle::European;
+    req.scheme = SchemeType::PredictorCorrector;
+    req.NT = std::max(1, options.steps);
+    req.NSIM = std::max<std::int64_t>(1, paths);
+    req.seed = 1;
+    return req;
+}
+
+double StepsPerSecond(const PricingRequest& req, double seconds) {
+    return static_cast<double>(req.NSIM) * static_cast<double>(req.NT) / std::max(seconds, 1e-9);
+}
+
+// Single-thread path steps/s of one hub setup, best of reps
+double MeasureHub(const PricingRequest& req, const TuneProfile& setup, int reps) {
+    auto sde = MakeSDE(req.option);
+    auto fdm = MakeFDM(sde, req.scheme, req.NT);
+    auto rng = std::make_shared<MTEngRandNumGen>(req.seed);
+    double best = 0.0;
+    for (int r = 0; r < std::max(1, reps); ++r) {
+        std::shared_ptr<Pricer> pricer = MakePricer(req);
+        auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, req.NSIM);
+        hub.SetVerbose(false);
+        setup.Apply(hub);
+        const auto start = std::chrono::steady_clock::now();
+        hub.BeginSimulation();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::max(best, StepsPerSecond(req, seconds));
+    }
+    return best;
+}
+
+// Whole-pool path steps/s with `workers` threads, best of reps
+double MeasureScheduler(const PricingRequest& base, const TuneProfile& setup, int reps) {
+    PricingRequest req = base;
+    req.NSIM = base.NSIM * setup.workers;
+    JobScheduler scheduler(setup.SchedulerConfig());
+    double best = 0.0;
+    for (int r = 0; r < std::max(1, reps); ++r) {
+        const JobResult job = scheduler.Submit(req).get();
+        if (job.result.status != PricingStatus::Ok) {
+            throw std::runtime_error("Auto-tune calibration job failed");
+        }
+        best = std::max(best, StepsPerSecond(req, job.seconds));
+    }
+    return best;
+}
+
+// Sets *field to the fastest candidate; returns that candidate's rate
+template <typename T, typename Measure>
+double PickFastest(TuneProfile& profile, T TuneProfile::*field, const std::vector<T>& candidates, Measure measure) {
+    T best = candidates.front();
+    double bestRate = 0.0;
+    for (const T& c : candidates) {
+        profile.*field = c;
+        const double rate = measure(profile);
+        if (rate > bestRate) {
+            bestRate = rate;
+            best = c;
+        }
+    }
+    profile.*field = best;
+    return bestRate;
+}
+
+std::string CpuModel() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+        // x86 "model name", some ARM kernels "Processor" or "cpu model"
+        if (line.rfind("model name", 0) == 0 || line.rfind("Processor", 0) == 0
+            || line.rfind("cpu model", 0) == 0) {
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            const size_t start = line.find_first_not_of(" \t", colon + 1);
+            if (start != std::string::npos) return line.substr(start);
+        }
+    }
+    return "unknown CPU";
+}
+
+} // namespace
+
+std::string TuneProfile::Describe() const {
+    std::ostringstream out;
+    out << "block " << kernelBlockSize << " paths, RNG batch " << rngBatch << " steps, "
+        << (precision == Precision::Single ? "float32" : "float64") << " kernels, "
+        << workers << (workers == 1 ? " worker" : " workers") << ", "
+        << pathsPerBlock << " paths per task";
+    if (stepsPerSecond > 0.0) {
+        out << " (" << stepsPerSecond / 1e6 << " M path steps/s)";
+    }
+    return out.str();
+}
+
+std::string HostFingerprint() {
+    return CpuModel() + " x" + std::to_string(NumaTopology::Detect().NumCpus());
+}
+
+TuneProfile AutoTune(const AutoTuneOptions& options) {
+    TuneProfile profile;
+    profile.host = HostFingerprint();
+    const PricingRequest req = CalibrationRequest(options, options.paths);
+    auto hubRate = [&](const TuneProfile& p) { return MeasureHub(req, p, options.reps); };
+
+    // One parameter at a time, each under the best choices so far. The kernel
+    // variant goes first: it sets the vector width the block size has to fill.
+    std::vector<Precision> variants{Precision::Double};
+    if (options.allowSinglePrecision) variants.push_back(Precision::Single);
+    PickFastest(profile, &TuneProfile::precision, variants, hubRate);
+    PickFastest(profile, &TuneProfile::kernelBlockSize,
+                std::vector<size_t>{32, 64, 128, 256, 512, 1024, 2048, 4096}, hubRate);
+    PickFastest(profile, &TuneProfile::rngBatch, std::vector<size_t>{1, 2, 4, 8, 16, 64}, hubRate);
+    profile.pathsPerBlock = std::max<std::int64_t>(4096, 16 * static_cast<std::int64_t>(profile.kernelBlockSize));
+
+    // Threads: the fewest that reach (nearly) the best pool throughput, so SMT
+    // siblings or oversubscribed cores are left out when they add nothing
+    const auto cpus = static_cast<unsigned>(NumaTopology::Detect().NumCpus());
+    const unsigned maxWorkers = std::max(1u, options.maxWorkers != 0 ? std::min(options.maxWorkers, cpus) : cpus);
+    std::vector<unsigned> counts;
+    for (unsigned w = 1; w < maxWorkers; w *= 2) counts.push_back(w);
+    counts.push_back(maxWorkers);
+
+    const PricingRequest poolReq = CalibrationRequest(options, std::max<std::int64_t>(options.paths, profile.pathsPerBlock));
+    std::vector<double> rates;
+    for (unsigned w : counts) {
+        profile.workers = w;
+        rates.push_back(MeasureScheduler(poolReq, profile, options.reps));
+    }
+    const double best = *std::max_element(rates.begin(), rates.end());
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (rates[i] >= 0.97 * best) {
+            profile.workers = counts[i];
+            profile.stepsPerSecond = rates[i];
+            break;
+        }
+    }
+    return profile;
+}
+
+void SaveTuneProfile(const std::string& path, const TuneProfile& profile) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot write tune profile " + tmp);
+        }
+        out << "# monte_carlo auto-tune profile\n"
+            << "version " << TuneFileVersion << '\n'
+            << "host " << profile.host << '\n'
+            << "kernel_block_size " << profile.kernelBlockSize << '\n'
+            << "rng_batch " << profile.rngBatch << '\n'
+            << "kernel " << (profile.precision == Precision::Single ? "float32" : "float64") << '\n'
+            << "workers " << profile.workers << '\n'
+            << "paths_per_block " << profile.pathsPerBlock << '\n'
+            << "steps_per_second " << profile.stepsPerSecond << '\n';
+        if (!out.flush()) {
+            std::remove(tmp.c_str());
+            throw std::runtime_error("Failed to write tune profile " + path);
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Failed to write tune profile " + path);
+    }
+}
+
+std::optional<TuneProfile> LoadTuneProfile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return std::nullopt;
+
+    std::map<std::string, std::string> fields;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        const size_t space = line.find(' ');
+        fields[line.substr(0, space)] = space == std::string::npos ? "" : line.substr(space + 1);
+    }
+
+    TuneProfile p;
+    try {
+        if (std::stoi(fields.at("version")) != TuneFileVersion) throw std::invalid_argument("version");
+        p.host = fields.at("host");
+        p.kernelBlockSize = std::stoul(fields.at("kernel_block_size"));
+        p.rngBatch = std::stoul(fields.at("rng_batch"));
+        const std::string& kernel = fields.at("kernel");
+        if (kernel != "float64" && kernel != "float32") throw std::invalid_argument("kernel");
+        p.precision = kernel == "float32" ? Precision::Single : Precision::Double;
+        p.workers = static_cast<unsigned>(std::stoul(fields.at("workers")));
+        p.pathsPerBlock = std::stoll(fields.at("paths_per_block"));
+        p.stepsPerSecond = fields.count("steps_per_second") ? std::stod(fields.at("steps_per_second")) : 0.0;
+    }
+    catch (const std::exception&) {
+        throw std::runtime_error("Not a tune profile: " + path);
+    }
+    if (p.kernelBlockSize == 0 || p.rngBatch == 0 || p.workers == 0 || p.pathsPerBlock <= 0) {
+        throw std::runtime_error("Corrupt tune profile: " + path);
+    }
+    return p;
+}
+
+std::string DefaultTuneProfilePath() {
+    if (const char* explicitPath = std::getenv("MC_TUNE_PROFILE"); explicitPath && *explicitPath) {
+        return explicitPath;
+    }
+    std::filesystem::path dir;
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache && *cache) {
+        dir = cache;
+    }
+    else if (const char* home = std::getenv("HOME"); home && *home) {
+        dir = std::filesystem::path(home) / ".cache";
+    }
+    else {
+        return "mc_tune_profile";
+    }
+    return (dir / "monte_carlo" / "tune_profile").string();
+}
+
+TuneProfile LoadOrTune(const std::string& path, const AutoTuneOptions& options, bool* tuned) {
+    std::optional<TuneProfile> saved;
+    try {
+        saved = LoadTuneProfile(path);
+    }
+    catch (const std::runtime_error&) {
+        // Unreadable profile: tune again and overwrite it
+    }
+    if (saved && saved->host == HostFingerprint()) {
+        if (tuned) *tuned = false;
+        return *saved;
+    }
+
+    TuneProfile profile = AutoTune(options);
+    try {
+        const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+        SaveTuneProfile(path, profile);
+    }
+    catch (const std::exception&) {
+        // Read-only cache: run with the fresh profile anyway
+    }
+    if (tuned) *tuned = true;
+    return profile;
+}
@@ -0,0 +1,275 @@
+#include "Calibration.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "PricingEngine.hpp"
+
+namespace {
+
+double HalfSquaredNorm(const std::vector<double>& r) {
+    double s = 0.0;
+    for (double x : r) s += x * x;
+    return 0.5 * s;
+}
+
+// Solves A x = b for a small dense system by Gaussian elimination with
+// partial pivoting; false if A is singular
+bool SolveDense(std::vector<std::vector<double>> A, std::vector<double> b, std::vector<double>& x) {
+    const size_t n = b.size();
+    for (size_t c = 0; c < n; ++c) {
+        size_t pivot = c;
+        for (size_t r = c + 1; r < n; ++r) {
+            if (std::abs(A[r][c]) > std::abs(A[pivot][c])) pivot = r;
+        }
+        if (std::abs(A[pivot][c]) < 1e-300) return false;
+        std::swap(A[c], A[pivot]);
+        std::swap(b[c], b[pivot]);
+        for (size_t r = c + 1; r < n; ++r) {
+            const double f = A[r][c] / A[c][c];
+            for (size_t k = c; k < n; ++k) A[r][k] -= f * A[c][k];
+            b[r] -= f * b[c];
+        }
+    }
+    x.assign(n, 0.0);
+    for (size_t c = n; c-- > 0;) {
+        double s = b[c];
+        for (size_t k = c + 1; k < n; ++k) s -= A[c][k] * x[k];
+        x[c] = s / A[c][c];
+    }
+    return true;
+}
+
+} // namespace
+
+CalibrationModel VolatilityModel(double initialSig) {
+    CalibrationModel m;
+    m.names = {"sig"};
+    m.initial = {initialSig};
+    m.lower = {1e-4};
+    m.upper = {5.0};
+    m.build = [](const OptionData& o, const std::vector<double>& p) {
+        OptionData d = o;
+        d.sig = p[0];
+        return MakeSDE(d);
+    };
+    return m;
+}
+
+CalibrationModel CEVModel(double initialSig, double initialBeta) {
+    CalibrationModel m;
+    m.names = {"sig", "beta"};
+    m.initial = {initialSig, initialBeta};
+    m.lower = {1e-4, 0.05};
+    m.upper = {50.0, 1.5};
+    m.build = [](const OptionData& o, const std::vector<double>& p) {
+        OptionData d = o;
+        d.sig = p[0];
+        d.betaCEV = p[1];
+        return MakeSDE(d);
+    };
+    return m;
+}
+
+Calibrator::Calibrator(std::vector<CalibrationInstrument> instrumentList, CalibrationModel calibrationModel,
+                       CalibrationConfig config)
+    : instruments(std::move(instrumentList))
+    , model(std::move(calibrationModel))
+    , cfg(std::move(config))
+{
+    const size_t m = model.initial.size();
+    if (instruments.empty()) {
+        throw std::runtime_error("Calibration needs at least one instrument");
+    }
+    if (m == 0 || model.lower.size() != m || model.upper.size() != m || !model.build) {
+        throw std::runtime_error("Calibration model needs initial values, bounds and a builder");
+    }
+    for (size_t i = 0; i < m; ++i) {
+        if (!(model.lower[i] < model.upper[i])) {
+            throw std::runtime_error("Calibration bounds must satisfy lower < upper");
+        }
+    }
+    if (cfg.paths <= 0 || cfg.steps <= 0) {
+        throw std::runtime_error("Calibration needs positive paths and steps");
+    }
+    if (cfg.blockSize == 0) {
+        // Path-by-path mode draws two normals per step and would exhaust the cache
+        throw std::runtime_error("Calibration needs block mode (blockSize > 0)");
+    }
+    // Block mode draws one normal per path and step
+    const size_t count = static_cast<size_t>(cfg.paths) * static_cast<size_t>(cfg.steps);
+    normals = cfg.normalsFile.empty() ? NormalCache::InMemory(cfg.seed, count)
+                                      : NormalCache::Mapped(cfg.normalsFile, cfg.seed, count);
+}
+
+double Calibrator::PriceOne(const CalibrationInstrument& instrument, const std::vector<double>& p) const {
+    PricingRequest req{instrument.option, instrument.style, cfg.scheme, cfg.steps, cfg.paths, 0};
+    auto sde = model.build(instrument.option, p);
+    auto fdm = MakeFDM(sde, cfg.scheme, cfg.steps);
+    std::shared_ptr<Pricer> pricer = MakePricer(req);
+    auto rng = std::make_shared<CachedNormalGen>(normals);
+    auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+    MCCentralHub<SDEGeneral, Pricer, FDMType, CachedNormalGen> hub(pieces, cfg.paths);
+    hub.SetVerbose(false);
+    hub.SetBlockSize(cfg.blockSize);
+    hub.BeginSimulation();
+    return pricer->OptionPrice();
+}
+
+std::vector<std::vector<double>> Calibrator::PriceAll(const std::vector<std::vector<double>>& paramSets) {
+    const size_t n = instruments.size();
+    const size_t tasks = paramSets.size() * n;
+    std::vector<std::vector<double>> prices(paramSets.size(), std::vector<double>(n));
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex errorMtx;
+    std::string firstError;
+    auto work = [&] {
+        for (size_t t = next++; t < tasks && !failed; t = next++) {
+            try {
+                prices[t / n][t % n] = PriceOne(instruments[t % n], paramSets[t / n]);
+            }
+            catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(errorMtx);
+                if (!failed.exchange(true)) firstError = e.what();
+            }
+        }
+    };
+    const unsigned hw = cfg.workers != 0 ? cfg.workers : std::max(1u, std::thread::hardware_concurrency());
+    const auto threads = static_cast<unsigned>(std::min<size_t>(hw, tasks));
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < threads; ++w) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+    if (failed) {
+        throw std::runtime_error("Calibration pricing failed: " + firstError);
+    }
+    pricings += static_cast<std::int64_t>(tasks);
+    return prices;
+}
+
+std::vector<double> Calibrator::Prices(const std::vector<double>& p) {
+    return PriceAll({Clamp(p)}).front();
+}
+
+std::vector<double> Calibrator::Clamp(std::vector<double> p) const {
+    for (size_t i = 0; i < p.size(); ++i) {
+        p[i] = std::clamp(p[i], model.lower[i], model.upper[i]);
+    }
+    return p;
+}
+
+CalibrationResult Calibrator::Run() {
+    const size_t m = model.initial.size();
+    const size_t n = instruments.size();
+    auto residuals = [&](const std::vector<double>& prices) {
+        std::vector<double> r(n);
+        for (size_t i = 0; i < n; ++i) {
+            r[i] = instruments[i].weight * (prices[i] - instruments[i].marketPrice);
+        }
+        return r;
+    };
+
+    const std::int64_t pricingsBefore = pricings;
+    CalibrationResult res;
+    res.params = Clamp(model.initial);
+    res.modelPrices = Prices(res.params);
+    std::vector<double> r = residuals(res.modelPrices);
+    res.cost = HalfSquaredNorm(r);
+    double lambda = 1e-3;
+
+    while (res.iterations < cfg.maxIterations && !res.converged && !res.stalled) {
+        ++res.iterations;
+
+        // Central differences, one-sided at a bound; all bumped points at once
+        std::vector<std::vector<double>> points;
+        std::vector<double> steps(m);
+        for (size_t k = 0; k < m; ++k) {
+            const double h = cfg.relativeBump * std::max(std::abs(res.params[k]), 1e-3);
+            std::vector<double> up = res.params;
+            std::vector<double> down = res.params;
+            up[k] = std::min(up[k] + h, model.upper[k]);
+            down[k] = std::max(down[k] - h, model.lower[k]);
+            steps[k] = up[k] - down[k];
+            points.push_back(std::move(up));
+            points.push_back(std::move(down));
+        }
+        const auto bumped = PriceAll(points);
+
+        // J^T J and J^T r of the weighted residuals
+        std::vector<std::vector<double>> JtJ(m, std::vector<double>(m, 0.0));
+        std::vector<double> Jtr(m, 0.0);
+        std::vector<std::vector<double>> J(n, std::vector<double>(m));
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t k = 0; k < m; ++k) {
+                J[i][k] = instruments[i].weight * (bumped[2 * k][i] - bumped[2 * k + 1][i]) / steps[k];
+            }
+        }
+        double gradMax = 0.0;
+        for (size_t k = 0; k < m; ++k) {
+            for (size_t i = 0; i < n; ++i) {
+                Jtr[k] += J[i][k] * r[i];
+                for (size_t l = 0; l < m; ++l) JtJ[k][l] += J[i][k] * J[i][l];
+            }
+            gradMax = std::max(gradMax, std::abs(Jtr[k]));
+        }
+        if (gradMax <= cfg.tolerance * std::max(res.cost, 1e-300)) {
+            res.converged = true;
+            break;
+        }
+
+        // Damped steps until one lowers the cost
+        while (true) {
+            std::vector<std::vector<double>> A = JtJ;
+            std::vector<double> b(m);
+            for (size_t k = 0; k < m; ++k) {
+                A[k][k] += lambda * std::max(JtJ[k][k], 1e-12);
+                b[k] = -Jtr[k];
+            }
+            // A singular system gives no step at all; more damping makes it
+            // diagonally dominant, so it is treated like an uphill step
+            std::vector<double> delta;
+            if (SolveDense(A, b, delta)) {
+                std::vector<double> trial = res.params;
+                for (size_t k = 0; k < m; ++k) trial[k] += delta[k];
+                trial = Clamp(trial);
+
+                double stepSize = 0.0;
+                for (size_t k = 0; k < m; ++k) {
+                    stepSize = std::max(stepSize, std::abs(trial[k] - res.params[k]) / std::max(std::abs(res.params[k]), 1e-12));
+                }
+                if (stepSize <= cfg.tolerance) {
+                    res.converged = true;
+                    break;
+                }
+
+                const std::vector<double> prices = Prices(trial);
+                const std::vector<double> rTrial = residuals(prices);
+                const double cost = HalfSquaredNorm(rTrial);
+                if (cost < res.cost) {
+                    const double decrease = (res.cost - cost) / std::max(res.cost, 1e-300);
+                    res.params = trial;
+                    res.modelPrices = prices;
+                    r = rTrial;
+                    res.cost = cost;
+                    lambda = std::max(lambda / 3.0, 1e-12);
+                    res.converged = decrease <= cfg.tolerance;
+                    break;
+                }
+            }
+            lambda *= 4.0;
+            if (lambda > 1e12) {
+                // No downhill step left at this resolution
+                res.stalled = true;
+                break;
+            }
+        }
+    }
+    res.pricings = pricings - pricingsBefore;
+    return res;
+}
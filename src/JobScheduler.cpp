@@ -0,0 +1,303 @@
+#include "JobScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include "PricingEngine.hpp"
+
+struct JobScheduler::Job {
+    // Simulated jobs are split into path blocks; the others are one task
+    enum class Route { Simulate, Reject, PDE };
+
+    std::uint64_t id{0};
+    Route route{Route::Simulate};
+    PricingRequest request;
+    std::uint64_t seed{0};
+    std::shared_ptr<SDEGeneral> sde;
+    std::shared_ptr<FDMType> fdm;
+    double discount{1.0};
+    std::atomic<std::int64_t> remaining{0};
+    std::atomic<bool> failed{false};
+    std::mutex statsMtx;
+    PathStatistics stats;
+    std::promise<JobResult> promise;
+    JobCallback callback;
+    std::shared_ptr<SimulationControl> control;
+    std::chrono::steady_clock::time_point submitted;
+};
+
+namespace {
+
+unsigned ResolveWorkers(unsigned workers) {
+    return workers != 0 ? workers : std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+JobScheduler::JobScheduler(Config config)
+    : cfg(config)
+    , topology(NumaTopology::Detect())
+    , workerCpu(ResolveWorkers(config.workers), -1)
+    , workersReady(static_cast<std::ptrdiff_t>(ResolveWorkers(config.workers)))
+{
+    cfg.workers = ResolveWorkers(cfg.workers);
+    if (cfg.pathsPerBlock <= 0) {
+        cfg.pathsPerBlock = 4096;
+    }
+    queues.resize(cfg.workers);
+    workerRng.resize(cfg.workers);
+    const std::vector<int> placement = topology.SpreadPlacement(cfg.workers);
+    for (unsigned w = 0; w < cfg.workers; ++w) {
+        workers.emplace_back([this, w, cpu = cfg.pinWorkers ? placement[w] : -1] {
+            if (cpu >= 0 && PinCurrentThread(cpu)) {
+                workerCpu[w] = cpu;
+            }
+            queues[w] = std::make_unique<WorkerQueue>();
+            workerRng[w] = std::make_shared<MTEngRandNumGen>();
+            workersReady.arrive_and_wait();
+            WorkerLoop(w);
+        });
+    }
+    // Workers steal from each other's queues, so all must exist before any runs
+    workersReady.wait();
+}
+
+JobScheduler::~JobScheduler() {
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+        stopping = true;
+    }
+    sleepCv.notify_all();
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+std::future<JobResult> JobScheduler::Submit(const PricingRequest& request, JobCallback callback,
+                                           std::shared_ptr<SimulationControl> control) {
+    auto job = std::make_shared<Job>();
+    job->id = nextJobId++;
+    job->request = request;
+    job->callback = std::move(callback);
+    job->control = std::move(control);
+    job->submitted = std::chrono::steady_clock::now();
+    auto fut = job->promise.get_future();
+
+    // Rejected and PDE-routed requests are answered by a worker too, so every
+    // callback runs on the pool and Submit never blocks on a solve
+    std::int64_t numBlocks = 1;
+    if (!ValidRequest(request)) {
+        job->route = Job::Route::Reject;
+    }
+    else if (cfg.routePDE && PDEEligible(request)) {
+        job->route = Job::Route::PDE;
+    }
+    else {
+        job->seed = request.seed != 0
+            ? request.seed
+            : (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+        job->sde = MakeSDE(request.option);
+        job->fdm = MakeFDM(job->sde, request.scheme, request.NT);
+        job->discount = std::exp(-request.option.r * request.option.T);
+        if (job->control) {
+            job->control->SetTarget(request.NSIM);
+            job->control->SetDiscount(job->discount);
+        }
+        numBlocks = (request.NSIM + cfg.pathsPerBlock - 1) / cfg.pathsPerBlock;
+    }
+    job->remaining = numBlocks;
+
+    ++activeJobs;
+    {
+        std::lock_guard<std::mutex> lock(injectMtx);
+        injected.push_back(Task{job, 0, numBlocks});
+    }
+    ++queuedTasks;
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+    }
+    sleepCv.notify_one();
+    return fut;
+}
+
+std::string JobScheduler::PlacementReport() const {
+    std::ostringstream out;
+    out << topology.Report();
+    out << "Workers: " << cfg.workers;
+    for (unsigned w = 0; w < cfg.workers; ++w) {
+        out << (w == 0 ? " [" : ", ");
+        if (workerCpu[w] < 0) {
+            out << "unpinned";
+        }
+        else {
+            out << "cpu " << workerCpu[w] << "/node " << topology.NodeOfCpu(workerCpu[w]);
+        }
+    }
+    out << "]\n";
+    return out.str();
+}
+
+void JobScheduler::WaitIdle() {
+    std::unique_lock<std::mutex> lock(sleepMtx);
+    idleCv.wait(lock, [this] { return activeJobs.load() == 0; });
+}
+
+void JobScheduler::PushLocal(size_t id, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(queues[id]->mtx);
+        queues[id]->tasks.push_back(std::move(task));
+    }
+    ++queuedTasks;
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+    }
+    sleepCv.notify_one();
+}
+
+bool JobScheduler::NextTask(size_t id, Task& task) {
+    // 1. newly submitted jobs, so small jobs never wait behind a large one
+    {
+        std::lock_guard<std::mutex> lock(injectMtx);
+        if (!injected.empty()) {
+            task = std::move(injected.front());
+            injected.pop_front();
+            --queuedTasks;
+            return true;
+        }
+    }
+    // 2. own deque, most recently split range first
+    {
+        std::lock_guard<std::mutex> lock(queues[id]->mtx);
+        auto& own = queues[id]->tasks;
+        if (!own.empty()) {
+            task = std::move(own.back());
+            own.pop_back();
+            --queuedTasks;
+            return true;
+        }
+    }
+    // 3. steal the oldest (largest) range from another worker
+    for (size_t k = 1; k < queues.size(); ++k) {
+        auto& victim = *queues[(id + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queuedTasks;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobScheduler::WorkerLoop(size_t id) {
+    while (true) {
+        Task task;
+        if (!NextTask(id, task)) {
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            sleepCv.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+            if (stopping && queuedTasks.load() == 0) return;
+            continue;
+        }
+
+        if (task.job->route != Job::Route::Simulate) {
+            FinishDirect(task.job);
+            continue;
+        }
+
+        // Keep the front block, leave the rest stealable
+        while (task.last - task.first > 1) {
+            const std::int64_t mid = task.first + (task.last - task.first) / 2;
+            PushLocal(id, Task{task.job, mid, task.last});
+            task.last = mid;
+        }
+        RunBlock(id, *task.job, task.first);
+        FinishBlock(task.job);
+    }
+}
+
+void JobScheduler::RunBlock(size_t id, Job& job, std::int64_t block) {
+    if (job.failed || (job.control && job.control->ShouldStop())) return;
+    try {
+        const std::int64_t done = block * cfg.pathsPerBlock;
+        const std::int64_t paths = std::min(cfg.pathsPerBlock, job.request.NSIM - done);
+
+        auto& rng = workerRng[id];
+        rng->SeedStream(job.seed, static_cast<std::uint64_t>(block));
+        std::shared_ptr<Pricer> pricer = MakePricer(job.request);
+        auto pieces = std::make_tuple(job.sde, pricer, job.fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, paths);
+        hub.SetVerbose(false);
+        hub.SetPrecision(cfg.precision);
+        hub.SetBlockSize(cfg.kernelBlockSize);
+        hub.SetRngBatch(cfg.rngBatch);
+        hub.AttachControl(job.control);
+        hub.AttachProfile(cfg.profile);
+        hub.BeginSimulation();
+
+        std::lock_guard<std::mutex> lock(job.statsMtx);
+        job.stats.Merge(pricer->Statistics());
+    }
+    catch (const std::exception&) {
+        job.failed = true;
+    }
+}
+
+void JobScheduler::FinishBlock(const std::shared_ptr<Job>& job) {
+    if (--job->remaining > 0) return;
+
+    JobResult res;
+    res.jobId = job->id;
+    res.stats = job->stats;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - job->submitted).count();
+    if (job->failed) {
+        res.result.status = PricingStatus::InternalError;
+    }
+    else {
+        const auto [sd, se] = res.stats.StandardDeviationStats();
+        res.result.price = res.stats.Price(job->discount);
+        res.result.stdDev = sd;
+        res.result.stdErr = se;
+        res.result.paths = res.stats.count;
+        if (res.stats.count < job->request.NSIM) {
+            res.result.status = PricingStatus::Cancelled;
+        }
+    }
+    Deliver(*job, res);
+}
+
+void JobScheduler::FinishDirect(const std::shared_ptr<Job>& job) {
+    JobResult res;
+    res.jobId = job->id;
+    if (job->route == Job::Route::Reject) {
+        res.result.status = PricingStatus::BadRequest;
+    }
+    else {
+        try {
+            res.result = PricePDE(job->request, cfg.pde);
+        }
+        catch (const std::exception&) {
+            res.result.status = PricingStatus::InternalError;
+        }
+    }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - job->submitted).count();
+    Deliver(*job, res);
+}
+
+void JobScheduler::Deliver(Job& job, const JobResult& res) {
+    if (job.callback) {
+        try {
+            job.callback(res);
+        }
+        catch (...) {
+        }
+    }
+    job.promise.set_value(res);
+
+    if (--activeJobs == 0) {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+        idleCv.notify_all();
+    }
+}
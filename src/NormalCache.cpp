@@ -0,0 +1,108 @@
+#include "NormalCache.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MTEngRandNumGen.hpp"
+
+namespace {
+
+constexpr char CacheMagic[8] = {'M', 'C', 'N', 'O', 'R', 'M', 'A', 'L'};
+constexpr std::uint32_t CacheVersion = 1;
+
+struct CacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t seed;
+    std::uint64_t count;
+    std::uint64_t padding[4];   // normals start on a 64-byte boundary
+};
+static_assert(sizeof(CacheHeader) == 64, "CacheHeader layout must not change");
+
+// Writes the cache file through a temporary, so readers never map a torn file
+void WriteCacheFile(const std::string& fileName, std::uint64_t seed, size_t count) {
+    const std::string tmp = fileName + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        throw std::runtime_error("Cannot write normal cache " + tmp + ": " + std::strerror(errno));
+    }
+    CacheHeader h{};
+    std::memcpy(h.magic, CacheMagic, sizeof(h.magic));
+    h.version = CacheVersion;
+    h.seed = seed;
+    h.count = count;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+
+    MTEngRandNumGen rng(seed);
+    std::vector<double> chunk(1 << 16);
+    for (size_t done = 0; ok && done < count;) {
+        const size_t n = std::min(chunk.size(), count - done);
+        for (size_t i = 0; i < n; ++i) chunk[i] = rng.GenerateRandNum();
+        ok = std::fwrite(chunk.data(), sizeof(double), n, f) == n;
+        done += n;
+    }
+    if (std::fclose(f) != 0 || !ok || std::rename(tmp.c_str(), fileName.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Failed to write normal cache " + fileName);
+    }
+}
+
+} // namespace
+
+std::shared_ptr<const NormalCache> NormalCache::InMemory(std::uint64_t seed, size_t count) {
+    std::shared_ptr<NormalCache> cache(new NormalCache());
+    cache->owned.resize(count);
+    MTEngRandNumGen rng(seed);
+    for (double& z : cache->owned) z = rng.GenerateRandNum();
+    cache->data = cache->owned.data();
+    cache->count = count;
+    cache->seed = seed;
+    return cache;
+}
+
+std::shared_ptr<const NormalCache> NormalCache::Mapped(const std::string& fileName, std::uint64_t seed, size_t count) {
+    auto matches = [&](int fd) {
+        CacheHeader h{};
+        struct stat st{};
+        return ::pread(fd, &h, sizeof(h), 0) == static_cast<ssize_t>(sizeof(h))
+            && std::memcmp(h.magic, CacheMagic, sizeof(h.magic)) == 0
+            && h.version == CacheVersion && h.seed == seed && h.count == count
+            && ::fstat(fd, &st) == 0
+            && static_cast<size_t>(st.st_size) == sizeof(CacheHeader) + count * sizeof(double);
+    };
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0 || !matches(fd)) {
+        if (fd >= 0) ::close(fd);
+        WriteCacheFile(fileName, seed, count);
+        fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open normal cache " + fileName + ": " + std::strerror(errno));
+        }
+    }
+
+    std::shared_ptr<NormalCache> cache(new NormalCache());
+    cache->mappedSize = sizeof(CacheHeader) + count * sizeof(double);
+    void* mapping = ::mmap(nullptr, cache->mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map normal cache " + fileName + ": " + std::strerror(errno));
+    }
+    cache->mapping = mapping;
+    cache->data = reinterpret_cast<const double*>(static_cast<const char*>(mapping) + sizeof(CacheHeader));
+    cache->count = count;
+    cache->seed = seed;
+    return cache;
+}
+
+NormalCache::~NormalCache() {
+    if (mapping) {
+        ::munmap(mapping, mappedSize);
+    }
+}
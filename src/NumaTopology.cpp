@@ -0,0 +1,138 @@
+#include "NumaTopology.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+
+std::vector<int> AllowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (size_t c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(static_cast<int>(c));
+        }
+    }
+    if (cpus.empty()) cpus.push_back(0);
+    return cpus;
+}
+
+// Compact "0-3,8" form for the report
+std::string FormatCpuList(const std::vector<int>& cpus) {
+    std::ostringstream out;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        if (i > 0) out << ',';
+        out << cpus[i];
+        if (j > i) out << '-' << cpus[j];
+        i = j + 1;
+    }
+    return out.str();
+}
+
+} // namespace
+
+NumaTopology::NumaTopology(std::vector<NumaNode> numaNodes)
+    : nodes(std::move(numaNodes))
+{}
+
+std::vector<int> NumaTopology::ParseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty() || item == "\n") continue;
+        const auto dash = item.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(item));
+            }
+            else {
+                const int lo = std::stoi(item.substr(0, dash));
+                const int hi = std::stoi(item.substr(dash + 1));
+                for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+            }
+        }
+        catch (const std::exception&) {
+            // ignore malformed entries
+        }
+    }
+    return cpus;
+}
+
+NumaTopology NumaTopology::Detect() {
+    const std::vector<int> allowed = AllowedCpus();
+    std::vector<NumaNode> found;
+
+    std::error_code ec;
+    const std::filesystem::path root("/sys/devices/system/node");
+    for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4
+            || !std::all_of(name.begin() + 4, name.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            continue;
+        }
+        std::ifstream in(entry.path() / "cpulist");
+        std::string list;
+        std::getline(in, list);
+        NumaNode node{std::stoi(name.substr(4)), {}};
+        for (int c : ParseCpuList(list)) {
+            if (std::binary_search(allowed.begin(), allowed.end(), c)) node.cpus.push_back(c);
+        }
+        if (!node.cpus.empty()) found.push_back(std::move(node));
+    }
+
+    if (found.empty()) {
+        found.push_back(NumaNode{0, allowed});
+    }
+    std::sort(found.begin(), found.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return NumaTopology(std::move(found));
+}
+
+size_t NumaTopology::NumCpus() const {
+    size_t n = 0;
+    for (const auto& node : nodes) n += node.cpus.size();
+    return n;
+}
+
+int NumaTopology::NodeOfCpu(int cpu) const {
+    for (const auto& node : nodes) {
+        if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end()) return node.id;
+    }
+    return -1;
+}
+
+std::vector<int> NumaTopology::SpreadPlacement(unsigned workers) const {
+    std::vector<int> placement;
+    if (nodes.empty()) return placement;
+    for (unsigned w = 0; w < workers; ++w) {
+        const auto& node = nodes[w % nodes.size()];
+        const size_t slot = (w / nodes.size()) % node.cpus.size();
+        placement.push_back(node.cpus[slot]);
+    }
+    return placement;
+}
+
+std::string NumaTopology::Report() const {
+    std::ostringstream out;
+    out << "NUMA nodes: " << nodes.size() << ", CPUs: " << NumCpus() << '\n';
+    for (const auto& node : nodes) {
+        out << "  node " << node.id << ": cpus " << FormatCpuList(node.cpus) << '\n';
+    }
+    return out.str();
+}
+
+bool PinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
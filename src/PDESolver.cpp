@@ -0,0 +1,306 @@
+#include "PDESolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "PricingEngine.hpp"
+
+namespace {
+
+// Quadratic through nodes i-1, i, i+1 of a uniform grid, evaluated at S;
+// i is the node nearest S, kept off the edges
+struct LocalFit {
+    double value;
+    double slope;
+    double curvature;
+};
+
+LocalFit FitAt(const std::vector<double>& spots, const std::vector<double>& values, double S) {
+    const size_t n = spots.size();
+    const double h = spots[1] - spots[0];
+    const double pos = std::clamp((S - spots[0]) / h, 0.0, static_cast<double>(n - 1));
+    const auto i = std::clamp<size_t>(static_cast<size_t>(std::lround(pos)), 1, n - 2);
+    const double x = pos - static_cast<double>(i);
+    const double first = 0.5 * (values[i + 1] - values[i - 1]);
+    const double second = values[i + 1] - 2.0 * values[i] + values[i - 1];
+    return LocalFit{
+        values[i] + x * first + 0.5 * x * x * second,
+        (first + x * second) / h,
+        second / (h * h)
+    };
+}
+
+// dV/dtau = a_i V_{i-1} + b_i V_i + c_i V_{i+1} at the interior nodes
+struct SpaceOperator {
+    std::vector<double> a;
+    std::vector<double> b;
+    std::vector<double> c;
+};
+
+void Assemble(const SDEGeneral& sde, double t, double r, const std::vector<double>& spots, double h,
+              SpaceOperator& op) {
+    for (size_t i = 1; i + 1 < spots.size(); ++i) {
+        const double mu = sde.drift(t, spots[i]);
+        const double sd = sde.diffusion(t, spots[i]);
+        const double diffusion = 0.5 * sd * sd / (h * h);
+        const double convection = 0.5 * mu / h;
+        double down = diffusion - convection;
+        double up = diffusion + convection;
+        // Central differences unless a weight turns negative, then upwind
+        if (down < 0.0 || up < 0.0) {
+            down = diffusion + std::max(-mu, 0.0) / h;
+            up = diffusion + std::max(mu, 0.0) / h;
+        }
+        op.a[i] = down;
+        op.b[i] = -(down + up) - r;
+        op.c[i] = up;
+    }
+}
+
+class ThetaStepper {
+public:
+    ThetaStepper(const SDEGeneral& sdeRef, const PDEConfig& config, std::vector<double> gridSpots,
+                 std::vector<double> exerciseValues, bool knockOut, double rate, double valueScale)
+        : sde(sdeRef)
+        , cfg(config)
+        , spots(std::move(gridSpots))
+        , intrinsic(std::move(exerciseValues))
+        , barrier(knockOut)
+        , r(rate)
+        , scale(valueScale)
+        , h(spots[1] - spots[0])
+    {
+        const size_t n = spots.size();
+        const size_t m = n - 2;
+        op.a.assign(n, 0.0);
+        op.b.assign(n, 0.0);
+        op.c.assign(n, 0.0);
+        lower.resize(m);
+        diag.resize(m);
+        upper.resize(m);
+        rhs.resize(m);
+        x.resize(m);
+    }
+
+    // Advances V from tau to tau + dt; t is the calendar time the step's
+    // coefficients are taken at. Returns the exercise iterations used.
+    int Step(std::vector<double>& V, double t, double dt, double theta) {
+        const size_t n = spots.size();
+        const size_t m = n - 2;
+        Assemble(sde, t, r, spots, h, op);
+
+        for (size_t i = 1; i + 1 < n; ++i) {
+            const double LV = op.a[i] * V[i - 1] + op.b[i] * V[i] + op.c[i] * V[i + 1];
+            const size_t j = i - 1;
+            rhs[j] = V[i] + (1.0 - theta) * dt * LV;
+            lower[j] = -theta * dt * op.a[i];
+            diag[j] = 1.0 - theta * dt * op.b[i];
+            upper[j] = -theta * dt * op.c[i];
+        }
+        // V_0 = 0 at a knock-out, else V_0 = 2 V_1 - V_2; V_N = 2 V_{N-1} - V_{N-2}
+        if (!barrier) {
+            diag[0] += 2.0 * lower[0];
+            upper[0] -= lower[0];
+        }
+        diag[m - 1] += 2.0 * upper[m - 1];
+        lower[m - 1] -= upper[m - 1];
+
+        int iterations = 0;
+        if (cfg.exercise == ExerciseStyle::European) {
+            SolveTridiagonal(lower, diag, upper, rhs, x, scratch);
+        }
+        else if (cfg.method == EarlyExercise::Penalty) {
+            iterations = Penalty();
+        }
+        else {
+            iterations = ProjectedSOR(V);
+        }
+
+        for (size_t j = 0; j < m; ++j) V[j + 1] = x[j];
+        V[0] = barrier ? 0.0 : 2.0 * V[1] - V[2];
+        V[n - 1] = 2.0 * V[n - 2] - V[n - 3];
+        if (cfg.exercise == ExerciseStyle::American) {
+            if (!barrier) V[0] = std::max(V[0], intrinsic[0]);
+            V[n - 1] = std::max(V[n - 1], intrinsic[n - 1]);
+        }
+        return iterations;
+    }
+
+private:
+    // (A + P) x = rhs + P g with P = 1/tolerance where x < g, repeated until
+    // the exercise region stops moving
+    int Penalty() {
+        const size_t m = x.size();
+        const double rho = 1.0 / cfg.tolerance;
+        penalised.assign(m, false);
+        SolveTridiagonal(lower, diag, upper, rhs, x, scratch);
+        std::vector<double>& d = penaltyDiag;
+        std::vector<double>& b = penaltyRhs;
+        for (int k = 1; k <= cfg.maxIterations; ++k) {
+            bool changed = false;
+            for (size_t j = 0; j < m; ++j) {
+                const bool active = x[j] < intrinsic[j + 1];
+                changed = changed || active != penalised[j];
+                penalised[j] = active;
+            }
+            if (!changed) return k;
+            d = diag;
+            b = rhs;
+            for (size_t j = 0; j < m; ++j) {
+                if (penalised[j]) {
+                    d[j] += rho;
+                    b[j] += rho * intrinsic[j + 1];
+                }
+            }
+            SolveTridiagonal(lower, d, upper, b, x, scratch);
+        }
+        throw std::runtime_error("PDE penalty iteration did not converge");
+    }
+
+    // Projected Gauss-Seidel with over-relaxation, started from the last layer
+    int ProjectedSOR(const std::vector<double>& V) {
+        const size_t m = x.size();
+        for (size_t j = 0; j < m; ++j) x[j] = std::max(V[j + 1], intrinsic[j + 1]);
+        for (int k = 1; k <= cfg.maxIterations; ++k) {
+            double change = 0.0;
+            for (size_t j = 0; j < m; ++j) {
+                double s = rhs[j];
+                if (j > 0) s -= lower[j] * x[j - 1];
+                if (j + 1 < m) s -= upper[j] * x[j + 1];
+                const double gs = s / diag[j];
+                const double next = std::max(intrinsic[j + 1], x[j] + cfg.psorOmega * (gs - x[j]));
+                change = std::max(change, std::abs(next - x[j]));
+                x[j] = next;
+            }
+            if (change <= cfg.tolerance * scale) return k;
+        }
+        throw std::runtime_error("PDE PSOR iteration did not converge");
+    }
+
+    const SDEGeneral& sde;
+    const PDEConfig& cfg;
+    std::vector<double> spots;
+    std::vector<double> intrinsic;
+    bool barrier;
+    double r;
+    double scale;
+    double h;
+
+    SpaceOperator op;
+    std::vector<double> lower, diag, upper, rhs, x, scratch;
+    std::vector<double> penaltyDiag, penaltyRhs;
+    std::vector<bool> penalised;
+};
+
+} // namespace
+
+double PDEResult::ValueAt(double S) const {
+    return FitAt(spots, values, S).value;
+}
+
+void SolveTridiagonal(const std::vector<double>& lower, const std::vector<double>& diag,
+                      const std::vector<double>& upper, const std::vector<double>& d,
+                      std::vector<double>& x, std::vector<double>& scratch) {
+    const size_t n = diag.size();
+    x.resize(n);
+    scratch.resize(n);
+    if (n == 0) return;
+    // Forward sweep: scratch holds the eliminated super-diagonal
+    double pivot = diag[0];
+    scratch[0] = upper[0] / pivot;
+    x[0] = d[0] / pivot;
+    for (size_t i = 1; i < n; ++i) {
+        pivot = diag[i] - lower[i] * scratch[i - 1];
+        scratch[i] = i + 1 < n ? upper[i] / pivot : 0.0;
+        x[i] = (d[i] - lower[i] * x[i - 1]) / pivot;
+    }
+    for (size_t i = n - 1; i-- > 0;) {
+        x[i] -= scratch[i] * x[i + 1];
+    }
+}
+
+PDEResult SolvePDE(const SDEGeneral& sde, const std::function<double(double)>& payoff, const PDEConfig& config) {
+    if (sde.jumps) {
+        throw std::runtime_error("PDE engine has no jump term; price jump diffusions by simulation");
+    }
+    if (!sde.data || !payoff) {
+        throw std::runtime_error("PDE engine needs option data and a payoff");
+    }
+    const OptionData& o = *sde.data;
+    if (!(o.T > 0.0) || !(o.S_0 > 0.0)) {
+        throw std::runtime_error("PDE engine needs T > 0 and S_0 > 0");
+    }
+    if (config.spaceSteps < 4 || config.timeSteps < 1 || !(config.width > 0.0) || !(config.tolerance > 0.0)
+        || (config.exercise == ExerciseStyle::American && config.method == EarlyExercise::PSOR
+            && !(config.psorOmega > 0.0 && config.psorOmega < 2.0))) {
+        throw std::runtime_error("Invalid PDE configuration");
+    }
+
+    PDEResult res;
+    const bool barrier = o.H > 0.0;
+    const double lowEdge = barrier ? o.H : 0.0;
+    const double vol = std::max(std::abs(sde.diffusion(0.0, o.S_0)) / o.S_0, 0.01);
+    const double highEdge = std::max(o.S_0, o.K) * std::exp(config.width * vol * std::sqrt(o.T));
+    if (barrier && o.S_0 <= o.H) {
+        // Already knocked out
+        res.spots = {o.H, o.S_0};
+        res.values = {0.0, 0.0};
+        return res;
+    }
+
+    const size_t n = config.spaceSteps + 1;
+    const double h = (highEdge - lowEdge) / static_cast<double>(config.spaceSteps);
+    res.spots.resize(n);
+    std::vector<double> intrinsic(n);
+    double scale = 1.0;
+    for (size_t i = 0; i < n; ++i) {
+        res.spots[i] = lowEdge + h * static_cast<double>(i);
+        intrinsic[i] = payoff(res.spots[i]);
+        scale = std::max(scale, std::abs(intrinsic[i]));
+    }
+    std::vector<double>& V = res.values;
+    V = intrinsic;
+    if (barrier) V[0] = 0.0;
+
+    ThetaStepper stepper(sde, config, res.spots, intrinsic, barrier, o.r, scale);
+    const double dt = o.T / static_cast<double>(config.timeSteps);
+    std::vector<double> previous;
+    for (size_t k = 0; k < config.timeSteps; ++k) {
+        if (k + 1 == config.timeSteps) previous = V;
+        const double tau = dt * static_cast<double>(k);
+        if (k < config.rannacherSteps) {
+            res.exerciseIterations += stepper.Step(V, o.T - tau - 0.25 * dt, 0.5 * dt, 1.0);
+            res.exerciseIterations += stepper.Step(V, o.T - tau - 0.75 * dt, 0.5 * dt, 1.0);
+        }
+        else {
+            res.exerciseIterations += stepper.Step(V, o.T - tau - 0.5 * dt, dt, 0.5);
+        }
+    }
+
+    const LocalFit fit = FitAt(res.spots, V, o.S_0);
+    res.price = fit.value;
+    res.delta = fit.slope;
+    res.gamma = fit.curvature;
+    res.theta = (FitAt(res.spots, previous, o.S_0).value - res.price) / dt;
+    return res;
+}
+
+bool PDEEligible(const PricingRequest& req) {
+    return ValidRequest(req) && req.style == PayoffStyle::European && req.option.H == 0.0;
+}
+
+PricingResult PricePDE(const PricingRequest& req, const PDEConfig& config) {
+    PricingResult res;
+    if (!PDEEligible(req)) {
+        res.status = PricingStatus::BadRequest;
+        return res;
+    }
+    try {
+        auto sde = MakeSDE(req.option);
+        res.price = SolvePDE(*sde, MakePayoff(req.option), config).price;
+    }
+    catch (const std::exception&) {
+        res.status = PricingStatus::InternalError;
+    }
+    return res;
+}
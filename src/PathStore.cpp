@@ -0,0 +1,178 @@
+#include "PathStore.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char StoreMagic[8] = {'M', 'C', 'P', 'A', 'T', 'H', 'S', '\0'};
+constexpr std::uint32_t StoreVersion = 1;
+constexpr std::uint64_t DataAlignment = 64;
+
+std::uint64_t DataOffset(std::uint64_t pathSize, std::uint64_t numObservations) {
+    const std::uint64_t end = sizeof(PathStoreHeader) + pathSize * sizeof(double)
+                            + numObservations * sizeof(std::uint64_t);
+    return (end + DataAlignment - 1) / DataAlignment * DataAlignment;
+}
+
+} // namespace
+
+PathStoreWriter::PathStoreWriter(const std::string& fileName, PathStoreInfo storeInfo, Precision prec)
+    : info(std::move(storeInfo))
+    , precision(prec)
+{
+    if (info.times.size() < 2) {
+        throw std::runtime_error("Path store needs a time grid");
+    }
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Cannot create path store " + fileName + ": " + std::strerror(errno));
+    }
+
+    PathStoreHeader h{};
+    std::memcpy(h.magic, StoreMagic, sizeof(h.magic));
+    h.version = StoreVersion;
+    h.precision = static_cast<std::uint32_t>(precision);
+    h.numPaths = 0;
+    h.pathSize = info.times.size();
+    h.numObservations = info.observations.size();
+    h.dataOffset = DataOffset(h.pathSize, h.numObservations);
+    h.seed = info.seed;
+    h.scheme = static_cast<std::int32_t>(info.scheme);
+    const OptionData& o = info.option;
+    h.optionType = o.type;
+    h.S_0 = o.S_0; h.K = o.K; h.T = o.T; h.r = o.r; h.sig = o.sig;
+    h.D = o.D; h.H = o.H; h.betaCEV = o.betaCEV; h.scale = o.scale;
+
+    std::vector<std::uint64_t> obs(info.observations.begin(), info.observations.end());
+    const std::vector<char> padding(h.dataOffset - sizeof(h) - info.times.size() * sizeof(double)
+                                    - obs.size() * sizeof(std::uint64_t), 0);
+    const bool ok = std::fwrite(&h, sizeof(h), 1, file) == 1
+        && std::fwrite(info.times.data(), sizeof(double), info.times.size(), file) == info.times.size()
+        && std::fwrite(obs.data(), sizeof(std::uint64_t), obs.size(), file) == obs.size()
+        && std::fwrite(padding.data(), 1, padding.size(), file) == padding.size();
+    if (!ok) {
+        std::fclose(file);
+        file = nullptr;
+        throw std::runtime_error("Cannot write path store header to " + fileName);
+    }
+    floatBuffer.resize(info.times.size());
+}
+
+PathStoreWriter::~PathStoreWriter() {
+    try {
+        Close();
+    }
+    catch (...) {
+    }
+}
+
+void PathStoreWriter::Append(std::span<const double> path) {
+    if (!file) {
+        throw std::runtime_error("Path store is closed");
+    }
+    if (path.size() != info.times.size()) {
+        throw std::runtime_error("Path length does not match the path store grid");
+    }
+    size_t written = 0;
+    if (precision == Precision::Double) {
+        written = std::fwrite(path.data(), sizeof(double), path.size(), file);
+    }
+    else {
+        for (size_t j = 0; j < path.size(); ++j) {
+            floatBuffer[j] = static_cast<float>(path[j]);
+        }
+        written = std::fwrite(floatBuffer.data(), sizeof(float), floatBuffer.size(), file);
+    }
+    if (written != path.size()) {
+        throw std::runtime_error("Short write to path store");
+    }
+    ++numPaths;
+}
+
+void PathStoreWriter::Close() {
+    if (!file) return;
+    const bool ok = std::fseek(file, offsetof(PathStoreHeader, numPaths), SEEK_SET) == 0
+        && std::fwrite(&numPaths, sizeof(numPaths), 1, file) == 1;
+    const bool closed = std::fclose(file) == 0;
+    file = nullptr;
+    if (!ok || !closed) {
+        throw std::runtime_error("Cannot finalise path store");
+    }
+}
+
+PathStoreReader::PathStoreReader(const std::string& fileName) {
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open path store " + fileName + ": " + std::strerror(errno));
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(PathStoreHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a path store: " + fileName);
+    }
+    mappedSize = static_cast<size_t>(st.st_size);
+    mapping = ::mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map path store " + fileName + ": " + std::strerror(errno));
+    }
+    ::madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+
+    const auto* base = static_cast<const char*>(mapping);
+    PathStoreHeader h{};
+    std::memcpy(&h, base, sizeof(h));
+    const bool valid = std::memcmp(h.magic, StoreMagic, sizeof(h.magic)) == 0
+        && h.version == StoreVersion
+        && (h.precision == static_cast<std::uint32_t>(Precision::Double)
+            || h.precision == static_cast<std::uint32_t>(Precision::Single))
+        && h.pathSize >= 2
+        // Bound the sizes by the file before multiplying so nothing overflows
+        && h.pathSize <= mappedSize / sizeof(double)
+        && h.numObservations <= mappedSize / sizeof(std::uint64_t)
+        && h.dataOffset == DataOffset(h.pathSize, h.numObservations)
+        && h.dataOffset <= mappedSize
+        && h.numPaths <= (mappedSize - h.dataOffset) / (h.pathSize * h.precision);
+    if (!valid) {
+        ::munmap(mapping, mappedSize);
+        mapping = nullptr;
+        throw std::runtime_error("Corrupt or truncated path store " + fileName);
+    }
+
+    precision = static_cast<Precision>(h.precision);
+    numPaths = h.numPaths;
+    pathSize = h.pathSize;
+    data = base + h.dataOffset;
+
+    info.option = OptionData{
+        .K = h.K, .T = h.T, .r = h.r, .sig = h.sig, .D = h.D, .S_0 = h.S_0,
+        .type = h.optionType, .H = h.H, .betaCEV = h.betaCEV, .scale = h.scale
+    };
+    info.scheme = static_cast<SchemeType>(h.scheme);
+    info.seed = h.seed;
+    const auto* times = reinterpret_cast<const double*>(base + sizeof(h));
+    info.times.assign(times, times + pathSize);
+    const auto* obs = reinterpret_cast<const std::uint64_t*>(base + sizeof(h) + pathSize * sizeof(double));
+    info.observations.assign(obs, obs + h.numObservations);
+    // Pricers index paths with these unchecked
+    for (size_t idx : info.observations) {
+        if (idx >= pathSize) {
+            ::munmap(mapping, mappedSize);
+            mapping = nullptr;
+            throw std::runtime_error("Corrupt path store " + fileName + ": observation index out of range");
+        }
+    }
+}
+
+PathStoreReader::~PathStoreReader() {
+    if (mapping) {
+        ::munmap(mapping, mappedSize);
+    }
+}
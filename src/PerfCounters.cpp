@@ -0,0 +1,230 @@
+#include "PerfCounters.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+int OpenEvent(std::uint32_t type, std::uint64_t config) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // pid 0, cpu -1: the calling thread on whatever CPU it runs
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+// Per path/step rate, or "n/a"
+std::string Rate(bool valid, double value, std::int64_t per) {
+    if (!valid || per <= 0) return "n/a";
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.1f", value / static_cast<double>(per));
+    return buf;
+}
+
+} // namespace
+
+const char* PerfEventName(PerfEvent e) {
+    switch (e) {
+    case PerfEvent::Cycles: return "cycles";
+    case PerfEvent::Instructions: return "instructions";
+    case PerfEvent::BranchMisses: return "branch-misses";
+    case PerfEvent::LLCMisses: return "LLC-misses";
+    }
+    return "?";
+}
+
+PerfSample PerfSample::operator-(const PerfSample& startSample) const {
+    PerfSample d;
+    for (size_t i = 0; i < NumPerfEvents; ++i) {
+        d.valid[i] = valid[i] && startSample.valid[i] && values[i] >= startSample.values[i];
+        d.values[i] = d.valid[i] ? values[i] - startSample.values[i] : 0;
+    }
+    d.seconds = seconds - startSample.seconds;
+    return d;
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) {
+    for (size_t i = 0; i < NumPerfEvents; ++i) {
+        values[i] += other.values[i];
+        valid[i] = valid[i] && other.valid[i];
+    }
+    seconds += other.seconds;
+    return *this;
+}
+
+PerfCounterGroup::PerfCounterGroup()
+    : start(std::chrono::steady_clock::now())
+{
+    fds.fill(-1);
+#ifdef __linux__
+    constexpr std::uint64_t llcReadMiss = PERF_COUNT_HW_CACHE_LL
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    fds[static_cast<size_t>(PerfEvent::Cycles)] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    const int firstErrno = errno;
+    fds[static_cast<size_t>(PerfEvent::Instructions)] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[static_cast<size_t>(PerfEvent::BranchMisses)] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    int& llc = fds[static_cast<size_t>(PerfEvent::LLCMisses)];
+    llc = OpenEvent(PERF_TYPE_HW_CACHE, llcReadMiss);
+    if (llc < 0) {
+        // Some PMUs only expose the generic last-level miss event
+        llc = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    }
+    status = Available() ? "ok" : std::string("perf_event_open: ") + std::strerror(firstErrno);
+#else
+    status = "hardware counters need Linux perf_event_open";
+#endif
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounterGroup::Available() const {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+PerfSample PerfCounterGroup::Read() const {
+    PerfSample s;
+    s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#ifdef __linux__
+    for (size_t i = 0; i < NumPerfEvents; ++i) {
+        if (fds[i] < 0) continue;
+        std::uint64_t buf[3];   // value, time enabled, time running
+        if (read(fds[i], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) || buf[2] == 0) continue;
+        // Scale up if the PMU was multiplexed between more events than it has counters
+        const double scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+        s.values[i] = static_cast<std::uint64_t>(static_cast<double>(buf[0]) * scale);
+        s.valid[i] = true;
+    }
+#endif
+    return s;
+}
+
+PerfCounterGroup& ThreadPerfCounters() {
+    thread_local PerfCounterGroup counters;
+    return counters;
+}
+
+void PerfProfile::Record(const std::string& phase, const PerfSample& delta, std::int64_t paths, std::int64_t steps) {
+    std::lock_guard<std::mutex> lock(mtx);
+    const size_t thread = threads.try_emplace(std::this_thread::get_id(), threads.size()).first->second;
+    auto [it, fresh] = entries.try_emplace(std::make_tuple(phase, thread));
+    Entry& e = it->second;
+    if (fresh) {
+        e.phase = phase;
+        e.thread = thread;
+        e.counters = delta;
+    }
+    else {
+        e.counters += delta;
+    }
+    e.paths += paths;
+    e.steps += steps;
+}
+
+std::vector<PerfProfile::Entry> PerfProfile::Entries() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Entry> out;
+    for (const auto& [key, e] : entries) out.push_back(e);
+    return out;
+}
+
+std::vector<PerfProfile::Entry> PerfProfile::PhaseTotals() const {
+    std::vector<Entry> out;
+    for (const Entry& e : Entries()) {
+        if (out.empty() || out.back().phase != e.phase) {
+            out.push_back(e);
+            continue;
+        }
+        // Threads run concurrently: wall time of a phase is its longest thread
+        Entry& total = out.back();
+        const double wall = std::max(total.counters.seconds, e.counters.seconds);
+        total.counters += e.counters;
+        total.counters.seconds = wall;
+        total.paths += e.paths;
+        total.steps += e.steps;
+    }
+    return out;
+}
+
+std::string PerfProfile::Report(bool perThread) const {
+    std::ostringstream out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-12s %6s %12s %10s %12s %12s %6s %12s %12s %11s\n",
+                  "phase", "thread", "paths", "ns/path", "cycles/path", "instr/path", "IPC",
+                  "brmiss/path", "llcmiss/path", "cycles/step");
+    out << line;
+
+    auto row = [&](const Entry& e, const std::string& thread) {
+        const PerfSample& c = e.counters;
+        const bool ipcValid = c.Has(PerfEvent::Cycles) && c.Has(PerfEvent::Instructions) && c[PerfEvent::Cycles] > 0;
+        char ipc[16] = "n/a";
+        if (ipcValid) {
+            std::snprintf(ipc, sizeof(ipc), "%.2f", static_cast<double>(c[PerfEvent::Instructions])
+                                                    / static_cast<double>(c[PerfEvent::Cycles]));
+        }
+        std::snprintf(line, sizeof(line), "%-12s %6s %12lld %10s %12s %12s %6s %12s %12s %11s\n",
+                      e.phase.c_str(), thread.c_str(), static_cast<long long>(e.paths),
+                      Rate(true, c.seconds * 1e9, e.paths).c_str(),
+                      Rate(c.Has(PerfEvent::Cycles), static_cast<double>(c[PerfEvent::Cycles]), e.paths).c_str(),
+                      Rate(c.Has(PerfEvent::Instructions), static_cast<double>(c[PerfEvent::Instructions]), e.paths).c_str(),
+                      ipc,
+                      Rate(c.Has(PerfEvent::BranchMisses), static_cast<double>(c[PerfEvent::BranchMisses]), e.paths).c_str(),
+                      Rate(c.Has(PerfEvent::LLCMisses), static_cast<double>(c[PerfEvent::LLCMisses]), e.paths).c_str(),
+                      Rate(c.Has(PerfEvent::Cycles), static_cast<double>(c[PerfEvent::Cycles]), e.steps).c_str());
+        out << line;
+    };
+
+    const std::vector<Entry> all = perThread ? Entries() : std::vector<Entry>{};
+    for (const Entry& total : PhaseTotals()) {
+        row(total, "all");
+        for (const Entry& e : all) {
+            if (e.phase == total.phase) row(e, std::to_string(e.thread));
+        }
+    }
+    if (!ThreadPerfCounters().Available()) {
+        out << "(hardware counters unavailable: " << ThreadPerfCounters().Status() << ")\n";
+    }
+    return out.str();
+}
+
+void PerfProfile::Clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    threads.clear();
+    entries.clear();
+}
+
+ScopedPerfPhase::ScopedPerfPhase(PerfProfile* prof, const char* name, std::int64_t numPaths, std::int64_t numSteps)
+    : profile(prof)
+    , phase(name)
+    , paths(numPaths)
+    , steps(numSteps)
+{
+    if (profile) start = ThreadPerfCounters().Read();
+}
+
+ScopedPerfPhase::~ScopedPerfPhase() {
+    if (profile) profile->Record(phase, ThreadPerfCounters().Read() - start, paths, steps);
+}
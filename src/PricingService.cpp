@@ -0,0 +1,392 @@
+#include "PricingService.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "PricingEngine.hpp"
+
+namespace {
+
+bool ReadFull(int fd, void* buf, size_t len) {
+    auto* p = static_cast<char*>(buf);
+    while (len > 0) {
+        const ssize_t n = ::recv(fd, p, len, 0);
+        if (n == 0) return false;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool WriteFull(int fd, const void* buf, size_t len) {
+    const auto* p = static_cast<const char*>(buf);
+    while (len > 0) {
+        const ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+sockaddr_un MakeAddress(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+} // namespace
+
+struct PricingService::Connection {
+    int fd{-1};
+    std::thread reader;
+    std::thread writer;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::future<PricingResult>> pending;
+    bool readerDone{false};
+    std::atomic<bool> finished{false};   // writer drained and closed fd
+};
+
+namespace {
+
+// How often the acceptor wakes to reap closed connections
+constexpr int ReapIntervalMs = 50;
+
+} // namespace
+
+PricingService::PricingService(Config config)
+    : cfg(std::move(config))
+{
+    if (cfg.workers == 0) {
+        cfg.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (cfg.maxBatch == 0) {
+        cfg.maxBatch = 1;
+    }
+}
+
+PricingService::~PricingService() {
+    Stop();
+}
+
+void PricingService::Start() {
+    if (running.exchange(true)) return;
+
+    for (size_t w = 0; w < cfg.workers; ++w) {
+        workerRng.push_back(std::make_shared<MTEngRandNumGen>());
+    }
+    for (size_t w = 0; w < cfg.workers; ++w) {
+        workers.emplace_back(&PricingService::WorkerLoop, this, w);
+    }
+
+    if (cfg.socketPath.empty()) return;  // in-process use only
+
+    const sockaddr_un addr = MakeAddress(cfg.socketPath);
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        Stop();
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    }
+    ::unlink(cfg.socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0
+        || ::listen(listenFd, 64) < 0) {
+        const std::string err = std::strerror(errno);
+        Stop();
+        throw std::runtime_error("bind/listen on " + cfg.socketPath + ": " + err);
+    }
+    acceptor = std::thread(&PricingService::AcceptLoop, this);
+}
+
+void PricingService::Stop() {
+    if (!running.exchange(false)) return;
+
+    if (listenFd >= 0) {
+        ::shutdown(listenFd, SHUT_RDWR);
+        ::close(listenFd);
+        listenFd = -1;
+    }
+    if (acceptor.joinable()) acceptor.join();
+
+    std::vector<std::shared_ptr<Connection>> conns;
+    {
+        std::lock_guard<std::mutex> lock(connMtx);
+        conns.swap(connections);
+    }
+    for (auto& c : conns) {
+        std::lock_guard<std::mutex> lock(c->mtx);
+        if (c->fd >= 0) ::shutdown(c->fd, SHUT_RDWR);
+    }
+    // Workers keep running until the connections have drained their futures;
+    // each writer closes its fd on the way out
+    for (auto& c : conns) {
+        if (c->reader.joinable()) c->reader.join();
+        if (c->writer.joinable()) c->writer.join();
+    }
+
+    queueCv.notify_all();
+    for (auto& w : workers) {
+        if (w.joinable()) w.join();
+    }
+    workers.clear();
+    workerRng.clear();
+
+    // Fail anything still queued
+    std::lock_guard<std::mutex> lock(queueMtx);
+    for (auto& job : queue) {
+        PricingResult res;
+        res.status = PricingStatus::InternalError;
+        job.promise.set_value(res);
+    }
+    queue.clear();
+
+    if (!cfg.socketPath.empty()) {
+        ::unlink(cfg.socketPath.c_str());
+    }
+}
+
+std::future<PricingResult> PricingService::Submit(const PricingRequest& request) {
+    Job job{request, {}, std::nullopt};
+    auto fut = job.promise.get_future();
+
+    if (request.NSIM > cfg.maxPaths) {
+        job.promise.set_value(PricingResult{PricingStatus::BadRequest, 0.0, 0.0, 0.0, 0});
+        return fut;
+    }
+
+    // The request's only cache lookup: full hits never reach the queue,
+    // partial ones travel with the job to the worker
+    if (cfg.cache && ValidRequest(request)) {
+        job.cached = cfg.cache->Lookup(request);
+        if (job.cached && job.cached->stats.count >= request.NSIM) {
+            job.promise.set_value(job.cached->Result());
+            ++served;
+            return fut;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMtx);
+        if (!running) {
+            PricingResult res;
+            res.status = PricingStatus::InternalError;
+            job.promise.set_value(res);
+            return fut;
+        }
+        queue.push_back(std::move(job));
+    }
+    queueCv.notify_one();
+    return fut;
+}
+
+void PricingService::WorkerLoop(size_t workerId) {
+    auto& rng = workerRng[workerId];
+    std::vector<Job> batch;
+    std::vector<PricingRequest> requests;
+    std::vector<std::optional<CacheEntry>> cached;
+
+    while (true) {
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> lock(queueMtx);
+            queueCv.wait(lock, [this] { return !running || !queue.empty(); });
+            if (!running && queue.empty()) return;
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+
+        // Collect batch mates already queued. Only when other work is pending
+        // (a burst is arriving) wait a moment for more; a lone request runs at once.
+        {
+            std::unique_lock<std::mutex> lock(queueMtx);
+            if (!queue.empty() && cfg.coalesceWindow.count() > 0) {
+                lock.unlock();
+                std::this_thread::sleep_for(cfg.coalesceWindow);
+                lock.lock();
+            }
+            for (auto it = queue.begin(); it != queue.end() && batch.size() < cfg.maxBatch;) {
+                if (SameUnderlying(it->request, batch.front().request)) {
+                    batch.push_back(std::move(*it));
+                    it = queue.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        requests.clear();
+        cached.clear();
+        for (auto& job : batch) {
+            requests.push_back(job.request);
+            cached.push_back(job.cached);
+        }
+
+        std::vector<PricingResult> results;
+        try {
+            results = cfg.cache ? PriceBatchCached(requests, rng, *cfg.cache, &cached)
+                                : PriceBatch(requests, rng);
+        }
+        catch (const std::exception&) {
+            results.assign(batch.size(), PricingResult{PricingStatus::InternalError, 0.0, 0.0, 0.0, 0});
+        }
+        ++simulations;
+        served += batch.size();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i].promise.set_value(results[i]);
+        }
+    }
+}
+
+size_t PricingService::ConnectionCount() {
+    std::lock_guard<std::mutex> lock(connMtx);
+    return connections.size();
+}
+
+void PricingService::ReapConnections() {
+    std::vector<std::shared_ptr<Connection>> done;
+    {
+        std::lock_guard<std::mutex> lock(connMtx);
+        auto it = std::partition(connections.begin(), connections.end(),
+                                 [](const auto& c) { return !c->finished.load(); });
+        done.assign(std::make_move_iterator(it), std::make_move_iterator(connections.end()));
+        connections.erase(it, connections.end());
+    }
+    for (auto& c : done) {
+        if (c->reader.joinable()) c->reader.join();
+        if (c->writer.joinable()) c->writer.join();
+    }
+}
+
+void PricingService::AcceptLoop() {
+    const int lfd = listenFd;
+    while (running) {
+        ReapConnections();
+
+        pollfd pfd{lfd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, ReapIntervalMs);
+        if (ready == 0) continue;
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if ((pfd.revents & POLLIN) == 0) return;  // listening socket shut down
+
+        const int fd = ::accept(lfd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // listening socket shut down
+        }
+        auto conn = std::make_shared<Connection>();
+        conn->fd = fd;
+        std::lock_guard<std::mutex> lock(connMtx);
+        if (!running) {
+            ::close(fd);
+            return;
+        }
+        conn->reader = std::thread(&PricingService::ReadLoop, this, conn);
+        conn->writer = std::thread(&PricingService::WriteLoop, this, conn);
+        connections.push_back(conn);
+    }
+}
+
+void PricingService::ReadLoop(std::shared_ptr<Connection> conn) {
+    WireRequest wire{};
+    while (ReadFull(conn->fd, &wire, sizeof(wire))) {
+        PricingRequest req;
+        std::future<PricingResult> fut;
+        if (DecodeRequest(wire, req)) {
+            fut = Submit(req);
+        }
+        else {
+            std::promise<PricingResult> bad;
+            PricingResult res;
+            res.status = PricingStatus::BadRequest;
+            bad.set_value(res);
+            fut = bad.get_future();
+        }
+        std::lock_guard<std::mutex> lock(conn->mtx);
+        conn->pending.push_back(std::move(fut));
+        conn->cv.notify_one();
+    }
+    std::lock_guard<std::mutex> lock(conn->mtx);
+    conn->readerDone = true;
+    conn->cv.notify_one();
+}
+
+void PricingService::WriteLoop(std::shared_ptr<Connection> conn) {
+    while (true) {
+        std::future<PricingResult> fut;
+        {
+            std::unique_lock<std::mutex> lock(conn->mtx);
+            conn->cv.wait(lock, [&] { return conn->readerDone || !conn->pending.empty(); });
+            if (conn->pending.empty()) {
+                // Reader has hit EOF and every response is out: release the fd
+                ::close(conn->fd);
+                conn->fd = -1;
+                conn->finished = true;
+                return;
+            }
+            fut = std::move(conn->pending.front());
+            conn->pending.pop_front();
+        }
+        const WireResponse wire = EncodeResponse(fut.get());
+        if (!WriteFull(conn->fd, &wire, sizeof(wire))) {
+            // Peer gone: keep draining so the futures are consumed
+            continue;
+        }
+    }
+}
+
+PricingClient::PricingClient(const std::string& socketPath) {
+    const sockaddr_un addr = MakeAddress(socketPath);
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0) {
+        const std::string err = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("connect to " + socketPath + ": " + err);
+    }
+}
+
+PricingClient::~PricingClient() {
+    if (fd >= 0) ::close(fd);
+}
+
+PricingResult PricingClient::Price(const PricingRequest& request) {
+    return PriceAll({request}).front();
+}
+
+std::vector<PricingResult> PricingClient::PriceAll(const std::vector<PricingRequest>& requests) {
+    for (const auto& req : requests) {
+        const WireRequest wire = EncodeRequest(req);
+        if (!WriteFull(fd, &wire, sizeof(wire))) {
+            throw std::runtime_error("Pricing service connection lost");
+        }
+    }
+    std::vector<PricingResult> results;
+    results.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        WireResponse wire{};
+        if (!ReadFull(fd, &wire, sizeof(wire))) {
+            throw std::runtime_error("Pricing service connection lost");
+        }
+        results.push_back(DecodeResponse(wire));
+    }
+    return results;
+}
@@ -0,0 +1,288 @@
+#include "ResultCache.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unistd.h>
+#include "PricingEngine.hpp"
+
+namespace {
+
+constexpr std::uint32_t KeyVersion = 1;
+constexpr char EntryMagic[4] = {'M', 'C', 'R', 'C'};
+
+template <typename T>
+void AppendBytes(std::vector<std::uint8_t>& out, T value) {
+    std::uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// -0.0 and 0.0 must produce the same key. Compared on the bits because
+// -ffast-math lets the compiler drop a floating point test for signed zero.
+void AppendDouble(std::vector<std::uint8_t>& out, double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7FFFFFFFFFFFFFFFull) == 0) {
+        bits = 0;
+    }
+    AppendBytes(out, bits);
+}
+
+std::uint64_t Fnv1a(const std::vector<std::uint8_t>& bytes) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (std::uint8_t b : bytes) {
+        h ^= b;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+// On-disk entry: magic, key length, key bytes, sum, squaredSum, count, discount
+struct DiskRecordTail {
+    double sum;
+    double squaredSum;
+    std::int64_t count;
+    double discount;
+};
+
+} // namespace
+
+ResultCache::ResultCache(size_t maxEntries, std::string persistDirectory)
+    : capacity(maxEntries == 0 ? 1 : maxEntries)
+    , directory(std::move(persistDirectory))
+{
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory);
+    }
+}
+
+std::vector<std::uint8_t> ResultCache::CanonicalKey(const PricingRequest& request) {
+    const OptionData& o = request.option;
+    std::vector<std::uint8_t> key;
+    key.reserve(128);
+    AppendBytes(key, KeyVersion);
+    for (double v : {o.K, o.T, o.r, o.sig, o.D, o.S_0, o.H, o.betaCEV, o.scale}) {
+        AppendDouble(key, v);
+    }
+    AppendBytes(key, static_cast<std::int32_t>(o.type));
+    AppendBytes(key, static_cast<std::int32_t>(request.style));
+    AppendBytes(key, static_cast<std::int32_t>(request.scheme));
+    AppendBytes(key, static_cast<std::int32_t>(request.NT));
+    AppendBytes(key, request.seed);
+    return key;
+}
+
+std::uint64_t ResultCache::Hash(const PricingRequest& request) {
+    return Fnv1a(CanonicalKey(request));
+}
+
+std::optional<CacheEntry> ResultCache::Lookup(const PricingRequest& request) {
+    if (!Cacheable(request)) return std::nullopt;
+    auto key = CanonicalKey(request);
+    const std::uint64_t hash = Fnv1a(key);
+
+    auto fromMemory = [&]() -> std::optional<CacheEntry> {
+        auto it = slots.find(hash);
+        if (it == slots.end() || it->second.key != key) return std::nullopt;
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        ++hits;
+        return it->second.entry;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (auto entry = fromMemory()) return entry;
+        if (directory.empty()) {
+            ++misses;
+            return std::nullopt;
+        }
+    }
+
+    auto loaded = LoadFromDisk(hash, key);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    // A store may have landed while the file was read; it is at least as new
+    if (auto entry = fromMemory()) return entry;
+    if (!loaded) {
+        ++misses;
+        return std::nullopt;
+    }
+    Insert(hash, std::move(key), *loaded);
+    ++hits;
+    return loaded;
+}
+
+void ResultCache::Store(const PricingRequest& request, const CacheEntry& entry) {
+    if (!Cacheable(request)) return;
+    auto key = CanonicalKey(request);
+    const std::uint64_t hash = Fnv1a(key);
+
+    if (!directory.empty()) {
+        SaveToDisk(hash, key, entry);
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    Insert(hash, std::move(key), entry);
+}
+
+void ResultCache::Clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    slots.clear();
+    lru.clear();
+}
+
+size_t ResultCache::Size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return slots.size();
+}
+
+std::uint64_t ResultCache::Hits() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return hits;
+}
+
+std::uint64_t ResultCache::Misses() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return misses;
+}
+
+void ResultCache::Insert(std::uint64_t hash, std::vector<std::uint8_t> key, const CacheEntry& entry) {
+    auto it = slots.find(hash);
+    if (it != slots.end()) {
+        // Same hash: newer entry (or a colliding key) replaces the old one
+        it->second.key = std::move(key);
+        it->second.entry = entry;
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        return;
+    }
+    if (slots.size() >= capacity) {
+        slots.erase(lru.back());
+        lru.pop_back();
+    }
+    lru.push_front(hash);
+    slots.emplace(hash, Slot{std::move(key), entry, lru.begin()});
+}
+
+std::string ResultCache::FileFor(std::uint64_t hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.mcr", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+std::optional<CacheEntry> ResultCache::LoadFromDisk(std::uint64_t hash, const std::vector<std::uint8_t>& key) const {
+    std::FILE* f = std::fopen(FileFor(hash).c_str(), "rb");
+    if (!f) return std::nullopt;
+
+    char magic[4];
+    std::uint32_t keySize = 0;
+    std::vector<std::uint8_t> storedKey;
+    DiskRecordTail tail{};
+    bool ok = std::fread(magic, sizeof(magic), 1, f) == 1
+        && std::memcmp(magic, EntryMagic, sizeof(magic)) == 0
+        && std::fread(&keySize, sizeof(keySize), 1, f) == 1
+        && keySize == key.size();
+    if (ok) {
+        storedKey.resize(keySize);
+        ok = std::fread(storedKey.data(), 1, keySize, f) == keySize
+            && storedKey == key
+            && std::fread(&tail, sizeof(tail), 1, f) == 1;
+    }
+    std::fclose(f);
+    if (!ok) return std::nullopt;
+
+    CacheEntry entry;
+    entry.stats = PathStatistics{tail.sum, tail.squaredSum, tail.count};
+    entry.discount = tail.discount;
+    return entry;
+}
+
+void ResultCache::SaveToDisk(std::uint64_t hash, const std::vector<std::uint8_t>& key, const CacheEntry& entry) const {
+    // Write to a temporary and rename so readers never see a partial record;
+    // the temporary is unique per process and write since stores run outside the lock
+    const std::string target = FileFor(hash);
+    const std::string tmp = target + "." + std::to_string(::getpid()) + "."
+        + std::to_string(writeSerial.fetch_add(1)) + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return;  // the persistent tier is best effort
+
+    const auto keySize = static_cast<std::uint32_t>(key.size());
+    const DiskRecordTail tail{entry.stats.sum, entry.stats.squaredSum, entry.stats.count, entry.discount};
+    const bool ok = std::fwrite(EntryMagic, sizeof(EntryMagic), 1, f) == 1
+        && std::fwrite(&keySize, sizeof(keySize), 1, f) == 1
+        && std::fwrite(key.data(), 1, key.size(), f) == key.size()
+        && std::fwrite(&tail, sizeof(tail), 1, f) == 1;
+    if (std::fclose(f) == 0 && ok) {
+        std::rename(tmp.c_str(), target.c_str());
+    }
+    else {
+        std::remove(tmp.c_str());
+    }
+}
+
+std::vector<PricingResult> PriceBatchCached(const std::vector<PricingRequest>& batch,
+                                            std::shared_ptr<MTEngRandNumGen>& rng,
+                                            ResultCache& cache,
+                                            const std::vector<std::optional<CacheEntry>>* lookedUp) {
+    std::vector<PricingResult> results(batch.size());
+
+    // Requests still needing paths: the extra-path request and the entry it extends
+    std::vector<size_t> pendingIdx;
+    std::vector<PricingRequest> pending;
+    std::vector<CacheEntry> partial;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const PricingRequest& req = batch[i];
+        if (!ValidRequest(req)) {
+            results[i].status = PricingStatus::BadRequest;
+            continue;
+        }
+        CacheEntry entry;
+        entry.discount = std::exp(-req.option.r * req.option.T);
+        if (auto hit = lookedUp ? (*lookedUp)[i] : cache.Lookup(req)) {
+            if (hit->stats.count >= req.NSIM) {
+                results[i] = hit->Result();
+                continue;
+            }
+            entry = *hit;
+        }
+        PricingRequest extra = req;
+        extra.NSIM = req.NSIM - entry.stats.count;
+        if (entry.stats.count > 0) {
+            extra.seed = TopUpSeed(req.seed, entry.stats.count);
+        }
+        pendingIdx.push_back(i);
+        pending.push_back(extra);
+        partial.push_back(entry);
+    }
+
+    // One shared-path simulation per underlying among the misses
+    std::vector<bool> done(pending.size(), false);
+    for (size_t first = 0; first < pending.size(); ++first) {
+        if (done[first]) continue;
+        std::vector<size_t> group;
+        std::vector<PricingRequest> groupRequests;
+        for (size_t k = first; k < pending.size(); ++k) {
+            if (!done[k] && SameUnderlying(pending[k], pending[first])) {
+                done[k] = true;
+                group.push_back(k);
+                groupRequests.push_back(pending[k]);
+            }
+        }
+
+        std::vector<PathStatistics> stats;
+        const auto groupResults = PriceBatch(groupRequests, rng, &stats);
+        for (size_t g = 0; g < group.size(); ++g) {
+            const size_t k = group[g];
+            const size_t i = pendingIdx[k];
+            if (groupResults[g].status != PricingStatus::Ok) {
+                results[i] = groupResults[g];
+                continue;
+            }
+            partial[k].stats.Merge(stats[g]);
+            cache.Store(batch[i], partial[k]);
+            results[i] = partial[k].Result();
+        }
+    }
+    return results;
+}
@@ -0,0 +1,267 @@
+#include "ShardRun.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include "PricingEngine.hpp"
+
+namespace {
+
+constexpr char ShardMagic[4] = {'M', 'C', 'S', 'H'};
+constexpr std::uint32_t ShardFileVersion = 2;
+
+// On-disk layout of a ShardState, native endianness like the path store
+struct ShardRecord {
+    char magic[4];
+    std::uint32_t version;
+    WireRequest request;
+    std::uint64_t shardIndex;
+    std::uint64_t shardCount;
+    std::int64_t pathsPerBlock;
+    std::uint64_t kernelBlockSize;
+    std::uint32_t precision;
+    std::uint32_t reserved;
+    std::int64_t firstBlock;
+    std::int64_t lastBlock;
+    std::int64_t nextBlock;
+    double sum;
+    double squaredSum;
+    std::int64_t count;
+    double discount;
+};
+static_assert(sizeof(ShardRecord) == 216, "ShardRecord layout must not change");
+
+bool SameRequest(const PricingRequest& a, const PricingRequest& b) {
+    const WireRequest wa = EncodeRequest(a);
+    const WireRequest wb = EncodeRequest(b);
+    return std::memcmp(&wa, &wb, sizeof(WireRequest)) == 0;
+}
+
+bool SameRun(const ShardState& a, const ShardState& b) {
+    return SameRequest(a.request, b.request) && a.shard.count == b.shard.count
+        && a.pathsPerBlock == b.pathsPerBlock && a.kernelBlockSize == b.kernelBlockSize
+        && a.precision == b.precision;
+}
+
+std::int64_t NumBlocks(const PricingRequest& request, std::int64_t pathsPerBlock) {
+    return (request.NSIM + pathsPerBlock - 1) / pathsPerBlock;
+}
+
+} // namespace
+
+ShardSpec ShardSpec::Parse(const std::string& text) {
+    const size_t slash = text.find('/');
+    ShardSpec spec;
+    try {
+        if (slash == std::string::npos) throw std::invalid_argument("no slash");
+        size_t used = 0;
+        spec.index = std::stoull(text.substr(0, slash), &used);
+        if (used != slash) throw std::invalid_argument("index");
+        const std::string countText = text.substr(slash + 1);
+        spec.count = std::stoull(countText, &used);
+        if (used != countText.size()) throw std::invalid_argument("count");
+    }
+    catch (const std::exception&) {
+        throw std::runtime_error("Shard spec must look like i/n, got '" + text + "'");
+    }
+    if (spec.count == 0 || spec.index >= spec.count) {
+        throw std::runtime_error("Shard index must be below the shard count in '" + text + "'");
+    }
+    return spec;
+}
+
+std::pair<std::int64_t, std::int64_t> ShardSpec::BlockRange(std::int64_t numBlocks) const {
+    const auto n = static_cast<std::int64_t>(count);
+    const auto i = static_cast<std::int64_t>(index);
+    return {i * numBlocks / n, (i + 1) * numBlocks / n};
+}
+
+void SaveShardState(const std::string& path, const ShardState& state) {
+    ShardRecord rec{};
+    std::memcpy(rec.magic, ShardMagic, sizeof(ShardMagic));
+    rec.version = ShardFileVersion;
+    rec.request = EncodeRequest(state.request);
+    rec.shardIndex = state.shard.index;
+    rec.shardCount = state.shard.count;
+    rec.pathsPerBlock = state.pathsPerBlock;
+    rec.kernelBlockSize = state.kernelBlockSize;
+    rec.precision = static_cast<std::uint32_t>(state.precision);
+    rec.firstBlock = state.firstBlock;
+    rec.lastBlock = state.lastBlock;
+    rec.nextBlock = state.nextBlock;
+    rec.sum = state.stats.sum;
+    rec.squaredSum = state.stats.squaredSum;
+    rec.count = state.stats.count;
+    rec.discount = state.discount;
+
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        throw std::runtime_error("Cannot write shard file " + tmp);
+    }
+    const bool ok = std::fwrite(&rec, sizeof(rec), 1, f) == 1;
+    if (std::fclose(f) != 0 || !ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Failed to write shard file " + path);
+    }
+}
+
+std::optional<ShardState> LoadShardState(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return std::nullopt;
+
+    ShardRecord rec{};
+    const bool read = std::fread(&rec, sizeof(rec), 1, f) == 1;
+    std::fclose(f);
+
+    ShardState state;
+    if (!read || std::memcmp(rec.magic, ShardMagic, sizeof(ShardMagic)) != 0
+        || rec.version != ShardFileVersion || !DecodeRequest(rec.request, state.request)) {
+        throw std::runtime_error("Not a shard file: " + path);
+    }
+    state.shard = ShardSpec{rec.shardIndex, rec.shardCount};
+    state.pathsPerBlock = rec.pathsPerBlock;
+    state.kernelBlockSize = rec.kernelBlockSize;
+    state.precision = static_cast<Precision>(rec.precision);
+    state.firstBlock = rec.firstBlock;
+    state.lastBlock = rec.lastBlock;
+    state.nextBlock = rec.nextBlock;
+    state.stats = PathStatistics{rec.sum, rec.squaredSum, rec.count};
+    state.discount = rec.discount;
+    if (state.shard.count == 0 || state.shard.index >= state.shard.count || state.pathsPerBlock <= 0
+        || (state.precision != Precision::Double && state.precision != Precision::Single)
+        || state.nextBlock < state.firstBlock || state.nextBlock > state.lastBlock) {
+        throw std::runtime_error("Corrupt shard file: " + path);
+    }
+    return state;
+}
+
+ShardState RunShard(const PricingRequest& request, const ShardSpec& shard,
+                    const std::string& statePath, const ShardRunConfig& config) {
+    if (!ValidRequest(request)) {
+        throw std::runtime_error("Invalid pricing request");
+    }
+    if (request.seed == 0) {
+        throw std::runtime_error("Sharded runs need a fixed non-zero seed");
+    }
+    if (config.pathsPerBlock <= 0 || shard.count == 0 || shard.index >= shard.count) {
+        throw std::runtime_error("Invalid shard spec or block size");
+    }
+
+    ShardState state;
+    state.request = request;
+    state.shard = shard;
+    state.pathsPerBlock = config.pathsPerBlock;
+    state.kernelBlockSize = config.kernelBlockSize;
+    state.precision = config.precision;
+    std::tie(state.firstBlock, state.lastBlock) = shard.BlockRange(NumBlocks(request, config.pathsPerBlock));
+    state.nextBlock = state.firstBlock;
+    state.discount = std::exp(-request.option.r * request.option.T);
+
+    if (auto saved = LoadShardState(statePath)) {
+        if (!SameRun(*saved, state) || saved->shard.index != shard.index) {
+            throw std::runtime_error("Checkpoint " + statePath + " belongs to a different run");
+        }
+        state = *saved;
+    }
+
+    auto sde = MakeSDE(request.option);
+    auto fdm = MakeFDM(sde, request.scheme, request.NT);
+    auto rng = std::make_shared<MTEngRandNumGen>(request.seed);
+
+    using Clock = std::chrono::steady_clock;
+    auto lastSave = Clock::now();
+    auto save = [&] {
+        SaveShardState(statePath, state);
+        lastSave = Clock::now();
+        if (config.onCheckpoint) config.onCheckpoint(state);
+    };
+
+    while (!state.Complete()) {
+        if (config.control && config.control->ShouldStop()) break;
+
+        const std::int64_t block = state.nextBlock;
+        const std::int64_t paths = std::min(config.pathsPerBlock, request.NSIM - block * config.pathsPerBlock);
+        rng->SeedStream(request.seed, static_cast<std::uint64_t>(block));
+        std::shared_ptr<Pricer> pricer = MakePricer(request);
+        auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, paths);
+        hub.SetVerbose(false);
+        hub.SetPrecision(config.precision);
+        hub.SetBlockSize(config.kernelBlockSize);
+        hub.BeginSimulation();
+
+        const PathStatistics blockStats = pricer->Statistics();
+        state.stats.Merge(blockStats);
+        ++state.nextBlock;
+        if (config.control) config.control->Record(paths, blockStats);
+
+        if (std::chrono::duration<double>(Clock::now() - lastSave).count() >= config.checkpointSeconds) {
+            save();
+        }
+    }
+    save();
+    return state;
+}
+
+ShardMerge MergeShardStates(const std::vector<ShardState>& states) {
+    if (states.empty()) {
+        throw std::runtime_error("No shard states to merge");
+    }
+    const ShardState& lead = states.front();
+    std::vector<std::uint64_t> seen;
+    seen.reserve(states.size());
+
+    ShardMerge merged;
+    for (const auto& s : states) {
+        if (!SameRun(s, lead)) {
+            throw std::runtime_error("Shard files belong to different runs");
+        }
+        seen.push_back(s.shard.index);
+        merged.stats.Merge(s.stats);
+        if (!s.Complete()) merged.incomplete.push_back(s.shard.index);
+    }
+    std::sort(seen.begin(), seen.end());
+    const auto repeat = std::adjacent_find(seen.begin(), seen.end());
+    if (repeat != seen.end()) {
+        throw std::runtime_error("Shard " + std::to_string(*repeat) + " appears more than once");
+    }
+    std::sort(merged.incomplete.begin(), merged.incomplete.end());
+
+    // Walk the gaps between the shards present
+    merged.missingCount = lead.shard.count - seen.size();
+    std::uint64_t next = 0;
+    seen.push_back(lead.shard.count);
+    for (std::uint64_t present : seen) {
+        for (; next < present && merged.missing.size() < MaxListedMissing; ++next) {
+            merged.missing.push_back(next);
+        }
+        next = present + 1;
+    }
+
+    const auto [sd, se] = merged.stats.StandardDeviationStats();
+    merged.result.price = merged.stats.Price(lead.discount);
+    merged.result.stdDev = sd;
+    merged.result.stdErr = se;
+    merged.result.paths = merged.stats.count;
+    if (merged.missingCount > 0 || !merged.incomplete.empty()) {
+        merged.result.status = PricingStatus::Cancelled;
+    }
+    return merged;
+}
+
+ShardMerge MergeShardFiles(const std::vector<std::string>& paths) {
+    std::vector<ShardState> states;
+    for (const auto& p : paths) {
+        auto s = LoadShardState(p);
+        if (!s) {
+            throw std::runtime_error("Cannot read shard file " + p);
+        }
+        states.push_back(std::move(*s));
+    }
+    return MergeShardStates(states);
+}
@@ -0,0 +1,383 @@
+#include "montecarlo.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "NumaTopology.hpp"
+#include "PricingEngine.hpp"
+
+namespace {
+
+using Hub = MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen>;
+
+constexpr size_t NumSchemes = 3;   // SchemeType values
+constexpr size_t NumStyles = 2;    // PayoffStyle values
+
+// Model objects of one worker, re-targeted in place for every block it runs.
+// The SDE, payoff and discount read the current option through this struct,
+// so switching options writes a few doubles instead of building
+// std::functions, and every scheme/style pair keeps its own reusable hub.
+struct WorkerModels {
+    CEVCoefficients cev{0.0, 0.0, 1.0};
+    double strike{0.0};
+    int type{1};
+    double discount{1.0};
+
+    std::shared_ptr<MTEngRandNumGen> rng;
+    std::shared_ptr<SDEGeneral> sde;
+    std::array<std::shared_ptr<FDMType>, NumSchemes> schemes;
+    std::array<std::shared_ptr<Pricer>, NumStyles> pricers;
+    std::array<std::unique_ptr<Hub>, NumSchemes * NumStyles> hubs;   // [scheme * NumStyles + style]
+
+    WorkerModels() : rng(std::make_shared<MTEngRandNumGen>()) {
+        const WorkerModels* m = this;
+        // Same arithmetic as MakeCEVSDE and MakePayoff, so results match the scheduler's
+        InputFunction drift = [m]([[maybe_unused]] double t, double S) { return m->cev.mu * S; };
+        InputFunction diffusion = [m]([[maybe_unused]] double t, double S) {
+            return m->cev.beta == 1.0 ? m->cev.sig * S : m->cev.sig * std::pow(S, m->cev.beta);
+        };
+        InputFunction diffusionDerivative = [m]([[maybe_unused]] double t, double S) {
+            return m->cev.beta == 1.0 ? m->cev.sig : m->cev.sig * m->cev.beta * std::pow(S, m->cev.beta - 1.0);
+        };
+        InputFunction driftCorrected = [drift, diffusion, diffusionDerivative](double t, double S) {
+            return drift(t, S) - 0.5 * diffusion(t, S) * diffusionDerivative(t, S);
+        };
+        sde = std::make_shared<SDEGeneral>(std::make_tuple(drift, diffusion, driftCorrected, diffusionDerivative),
+                                           OptionData{.K = 0.0, .T = 1.0, .r = 0.0, .sig = 0.0, .D = 0.0, .S_0 = 1.0,
+                                                      .type = 1, .H = 0.0, .betaCEV = 1.0, .scale = 1.0});
+        schemes[static_cast<size_t>(SchemeType::Euler)] = std::make_shared<FDMEuler>(sde, 1);
+        schemes[static_cast<size_t>(SchemeType::PredictorCorrector)] = std::make_shared<FDMPredictCorrect>(sde, 1);
+        schemes[static_cast<size_t>(SchemeType::LogEuler)] = std::make_shared<FDMLogEuler>(sde, 1);
+
+        std::function<double(double)> payoff = [m](double s) {
+            return m->type == -1 ? std::max<double>(0.0, m->strike - s) : std::max<double>(0.0, s - m->strike);
+        };
+        std::function<double()> discountFactor = [m]() { return m->discount; };
+        pricers[static_cast<size_t>(PayoffStyle::European)] = std::make_shared<EuropeanOptionPricer>(payoff, discountFactor);
+        pricers[static_cast<size_t>(PayoffStyle::Asian)] = std::make_shared<AsianOptionPricer>(payoff, discountFactor);
+
+        for (size_t s = 0; s < NumSchemes; ++s) {
+            for (size_t p = 0; p < NumStyles; ++p) {
+                auto hub = std::make_unique<Hub>(std::make_tuple(sde, pricers[p], schemes[s], rng), 1);
+                hub->SetVerbose(false);
+                hubs[s * NumStyles + p] = std::move(hub);
+            }
+        }
+    }
+};
+
+// One option of the current batch: blocks [firstTask, firstTask + numBlocks)
+// of the batch's task list, none if the request was rejected
+struct OptionSlot {
+    PricingRequest request;
+    std::uint64_t seed{0};
+    double discount{1.0};
+    std::int64_t firstTask{0};
+    std::int64_t numBlocks{0};
+};
+
+struct BlockResult {
+    PathStatistics stats;
+    bool failed{false};
+};
+
+PricingRequest ToRequest(const mc_option_spec& o, const mc_run_params& p) {
+    PricingRequest req;
+    req.option = OptionData{
+        .K = o.K,
+        .T = o.T,
+        .r = o.r,
+        .sig = o.sig,
+        .D = o.D,
+        .S_0 = o.S_0,
+        .type = o.type,
+        .H = 0.0,
+        .betaCEV = o.betaCEV,
+        .scale = 1.0
+    };
+    req.style = static_cast<PayoffStyle>(o.style);
+    req.scheme = static_cast<SchemeType>(p.scheme);
+    req.NT = p.NT;
+    req.NSIM = p.NSIM;
+    req.seed = p.seed;
+    return req;
+}
+
+void ToResult(const PricingResult& res, mc_result& out) {
+    out.status = static_cast<int32_t>(res.status);
+    out.reserved = 0;
+    out.price = res.price;
+    out.stdDev = res.stdDev;
+    out.stdErr = res.stdErr;
+    out.paths = res.paths;
+}
+
+bool KnownEnums(const mc_option_spec& o, const mc_run_params& p) {
+    return (o.style == MC_STYLE_EUROPEAN || o.style == MC_STYLE_ASIAN)
+        && (p.scheme == MC_SCHEME_EULER || p.scheme == MC_SCHEME_PREDICTOR_CORRECTOR || p.scheme == MC_SCHEME_LOG_EULER)
+        && (o.type == 1 || o.type == -1);
+}
+
+} // namespace
+
+// Worker pool with everything a batch needs allocated up front or kept from
+// earlier batches: per-worker models and hubs (built on the worker, after
+// pinning, for first-touch placement), per-option slots and per-block
+// results. Block b of an option runs on substream b of its seed, as in
+// JobScheduler, and the blocks are merged in order, so results do not depend
+// on the number of workers. Slots and block results only grow when a batch
+// has more options or blocks than any before it, and a worker's hubs only
+// when it meets a longer grid, so repeated batches do not allocate.
+struct mc_engine {
+    explicit mc_engine(const mc_engine_config* config)
+        : numWorkers(config && config->workers != 0 ? config->workers : std::max(1u, std::thread::hardware_concurrency()))
+        , pathsPerBlock(config && config->paths_per_block > 0 ? config->paths_per_block : 4096)
+        , seeder((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}())
+        , models(numWorkers)
+    {
+        const bool pin = config && config->pin_workers != 0;
+        const std::vector<int> placement = NumaTopology::Detect().SpreadPlacement(numWorkers);
+        std::latch ready(static_cast<std::ptrdiff_t>(numWorkers));
+        unsigned started = 0;
+        try {
+            for (; started < numWorkers; ++started) {
+                workers.emplace_back([this, w = started, &ready, cpu = pin ? placement[started] : -1] {
+                    if (cpu >= 0) PinCurrentThread(cpu);
+                    try {
+                        models[w] = std::make_unique<WorkerModels>();
+                    }
+                    catch (...) {
+                    }
+                    ready.count_down();
+                    WorkerLoop(w);
+                });
+            }
+        }
+        catch (...) {
+            // The started workers still count down the latch on this frame
+            ready.count_down(static_cast<std::ptrdiff_t>(numWorkers - started));
+            ready.wait();
+            Stop();
+            throw;
+        }
+        ready.wait();
+        if (std::any_of(models.begin(), models.end(), [](const auto& m) { return !m; })) {
+            Stop();
+            throw std::runtime_error("Engine worker setup failed");
+        }
+    }
+
+    ~mc_engine() { Stop(); }
+
+    mc_engine(const mc_engine&) = delete;
+    mc_engine& operator=(const mc_engine&) = delete;
+
+    // Batches on one engine run one at a time
+    void PriceBatch(const mc_option_spec* options, size_t n, const mc_run_params* params, size_t nParams,
+                    mc_result* results) {
+        std::lock_guard<std::mutex> call(batchMtx);
+        if (slots.size() < n) slots.resize(n);
+
+        std::int64_t tasks = 0;
+        for (size_t i = 0; i < n; ++i) {
+            OptionSlot& slot = slots[i];
+            const mc_run_params& p = params[nParams == 1 ? 0 : i];
+            slot.firstTask = tasks;
+            slot.numBlocks = 0;
+            if (!KnownEnums(options[i], p)) {
+                ToResult(PricingResult{PricingStatus::BadRequest, 0.0, 0.0, 0.0, 0}, results[i]);
+                continue;
+            }
+            slot.request = ToRequest(options[i], p);
+            if (!ValidRequest(slot.request)) {
+                ToResult(PricingResult{PricingStatus::BadRequest, 0.0, 0.0, 0.0, 0}, results[i]);
+                continue;
+            }
+            slot.seed = p.seed != 0 ? p.seed : seeder();
+            slot.discount = std::exp(-slot.request.option.r * slot.request.option.T);
+            slot.numBlocks = (slot.request.NSIM + pathsPerBlock - 1) / pathsPerBlock;
+            tasks += slot.numBlocks;
+        }
+        if (blocks.size() < static_cast<size_t>(tasks)) blocks.resize(static_cast<size_t>(tasks));
+        numOptions = n;
+
+        // Workers count finished blocks here, in the engine, so nothing they
+        // touch goes away when this call returns
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            nextTask = 0;
+            finishedTasks = 0;
+            totalTasks = tasks;
+            wake.notify_all();
+            done.wait(lock, [this] { return finishedTasks == totalTasks; });
+            totalTasks = 0;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const OptionSlot& slot = slots[i];
+            if (slot.numBlocks == 0) continue;
+            PathStatistics stats;
+            bool failed = false;
+            for (std::int64_t b = 0; b < slot.numBlocks; ++b) {
+                const BlockResult& block = blocks[static_cast<size_t>(slot.firstTask + b)];
+                stats.Merge(block.stats);
+                failed = failed || block.failed;
+            }
+            PricingResult res;
+            if (failed) {
+                res.status = PricingStatus::InternalError;
+            }
+            else {
+                const auto [sd, se] = stats.StandardDeviationStats();
+                res.price = stats.Price(slot.discount);
+                res.stdDev = sd;
+                res.stdErr = se;
+                res.paths = stats.count;
+            }
+            ToResult(res, results[i]);
+        }
+    }
+
+private:
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+        workers.clear();
+    }
+
+    void WorkerLoop(size_t id) {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            wake.wait(lock, [this] { return stopping || nextTask < totalTasks; });
+            if (nextTask >= totalTasks) return;
+            const std::int64_t task = nextTask++;
+            lock.unlock();
+            RunTask(id, task);
+            lock.lock();
+            if (++finishedTasks == totalTasks) {
+                done.notify_all();
+            }
+        }
+    }
+
+    void RunTask(size_t id, std::int64_t task) {
+        // The last slot starting at or before task; slots without blocks share
+        // their successor's firstTask and are skipped this way
+        const auto last = slots.begin() + static_cast<std::ptrdiff_t>(numOptions);
+        const auto it = std::upper_bound(slots.begin(), last, task,
+                                         [](std::int64_t t, const OptionSlot& s) { return t < s.firstTask; });
+        const OptionSlot& slot = *(it - 1);
+        const std::int64_t block = task - slot.firstTask;
+        BlockResult& out = blocks[static_cast<size_t>(task)];
+        out = BlockResult{};
+        try {
+            WorkerModels& m = *models[id];
+            const PricingRequest& req = slot.request;
+            *m.sde->data = req.option;
+            m.cev = CEVCoefficients{req.option.r - req.option.D, req.option.sig, req.option.betaCEV};
+            m.sde->closedForm = m.cev;
+            m.strike = req.option.K;
+            m.type = req.option.type;
+            m.discount = slot.discount;
+
+            const auto scheme = static_cast<size_t>(req.scheme);
+            const auto style = static_cast<size_t>(req.style);
+            m.schemes[scheme]->setUniformGrid(req.option.T, req.NT);
+            Pricer& pricer = *m.pricers[style];
+            pricer.ResetStatistics();
+            m.rng->SeedStream(slot.seed, static_cast<std::uint64_t>(block));
+
+            Hub& hub = *m.hubs[scheme * NumStyles + style];
+            hub.Reuse(std::min(pathsPerBlock, req.NSIM - block * pathsPerBlock));
+            hub.BeginSimulation();
+            out.stats = pricer.Statistics();
+        }
+        catch (...) {
+            out.failed = true;
+        }
+    }
+
+    const unsigned numWorkers;
+    const std::int64_t pathsPerBlock;
+    std::mt19937_64 seeder;                               // seeds of seed-0 options
+    std::vector<std::unique_ptr<WorkerModels>> models;    // filled in by each worker
+    std::vector<std::thread> workers;
+
+    std::mutex batchMtx;
+    std::vector<OptionSlot> slots;
+    size_t numOptions{0};
+    std::vector<BlockResult> blocks;
+
+    std::mutex mtx;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::int64_t nextTask{0};
+    std::int64_t totalTasks{0};
+    std::int64_t finishedTasks{0};
+    bool stopping{false};
+};
+
+extern "C" {
+
+uint32_t mc_api_version(void) {
+    return MC_API_VERSION;
+}
+
+int mc_engine_create(const mc_engine_config* config, mc_engine** engine) {
+    if (!engine) return MC_ERR_INVALID_ARGUMENT;
+    *engine = nullptr;
+    try {
+        *engine = new mc_engine(config);
+        return MC_OK;
+    }
+    catch (...) {
+        return MC_ERR_INTERNAL;
+    }
+}
+
+void mc_engine_destroy(mc_engine* engine) {
+    delete engine;
+}
+
+int mc_price_batch(mc_engine* engine, const mc_option_spec* options, size_t n,
+                   const mc_run_params* params, size_t n_params, mc_result* results) {
+    if (!engine || (n > 0 && (!options || !params || !results)) || (n_params != 1 && n_params != n)) {
+        return MC_ERR_INVALID_ARGUMENT;
+    }
+    if (n == 0) return MC_OK;
+    try {
+        engine->PriceBatch(options, n, params, n_params, results);
+        return MC_OK;
+    }
+    catch (...) {
+        // Only growing the engine's buffers can throw, before any block runs
+        for (size_t i = 0; i < n; ++i) {
+            ToResult(PricingResult{PricingStatus::InternalError, 0.0, 0.0, 0.0, 0}, results[i]);
+        }
+        return MC_ERR_INTERNAL;
+    }
+}
+
+const char* mc_status_string(int32_t status) {
+    switch (status) {
+    case MC_STATUS_OK: return "ok";
+    case MC_STATUS_BAD_REQUEST: return "bad request";
+    case MC_STATUS_INTERNAL_ERROR: return "internal error";
+    case MC_STATUS_CANCELLED: return "cancelled";
+    default: return "unknown status";
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,64 @@
+#ifndef HubTestUtil_HPP
+#define HubTestUtil_HPP
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include "MCCentralHub.hpp"
+#include "OptionData.hpp"
+#include "PricingEngine.hpp"
+
+// Shared option and MCCentralHub set-up for the tests.
+
+// At-the-money one-year call on GBM: K = S_0 = 100, r = 5%, sigma = 20%, no
+// dividend, barrier or CEV elasticity. Fixtures adjust the fields they test.
+inline OptionData TestOption() {
+    return OptionData{.K = 100.0, .T = 1.0, .r = 0.05, .sig = 0.2, .D = 0.0, .S_0 = 100.0,
+                      .type = 1, .H = 0.0, .betaCEV = 1.0, .scale = 1.0};
+}
+
+template <typename RNG = MTEngRandNumGen>
+using TestHub = MCCentralHub<SDEGeneral, Pricer, FDMType, RNG>;
+
+// Pieces that replace the request's defaults: MakeSDE(request.option),
+// MakeFDM(sde, request.scheme, request.NT) and a generator seeded with
+// request.seed (generators without a seed constructor must be passed in)
+template <typename RNG = MTEngRandNumGen>
+struct TestHubPieces {
+    std::shared_ptr<SDEGeneral> sde{};
+    std::shared_ptr<FDMType> fdm{};
+    std::shared_ptr<RNG> rng{};
+};
+
+// Hub for request.NSIM paths into pricer with printing off and blockSize set
+// (0 = path-by-path); not yet simulated
+template <typename RNG = MTEngRandNumGen>
+std::unique_ptr<TestHub<RNG>> MakeTestHub(const PricingRequest& request, std::shared_ptr<Pricer> pricer,
+                                          size_t blockSize, TestHubPieces<RNG> pieces = {}) {
+    if (!pieces.sde) pieces.sde = MakeSDE(request.option);
+    if (!pieces.fdm) pieces.fdm = MakeFDM(pieces.sde, request.scheme, request.NT);
+    if constexpr (std::is_constructible_v<RNG, decltype(request.seed)>) {
+        if (!pieces.rng) pieces.rng = std::make_shared<RNG>(request.seed);
+    }
+    auto hub = std::make_unique<TestHub<RNG>>(
+        std::make_tuple(pieces.sde, std::move(pricer), pieces.fdm, pieces.rng), request.NSIM);
+    hub->SetVerbose(false);
+    hub->SetBlockSize(blockSize);
+    return hub;
+}
+
+// MakeTestHub, then configure (optional) and BeginSimulation; returns the
+// finished hub. configure does not take part in deducing RNG, so lambdas bind
+template <typename RNG = MTEngRandNumGen>
+std::unique_ptr<TestHub<RNG>> RunTestHub(const PricingRequest& request, std::shared_ptr<Pricer> pricer,
+                                         size_t blockSize,
+                                         const std::function<void(TestHub<std::type_identity_t<RNG>>&)>& configure = {},
+                                         TestHubPieces<RNG> pieces = {}) {
+    auto hub = MakeTestHub<RNG>(request, std::move(pricer), blockSize, std::move(pieces));
+    if (configure) configure(*hub);
+    hub->BeginSimulation();
+    return hub;
+}
+
+#endif
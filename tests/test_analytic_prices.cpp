@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include "AnalyticPrices.hpp"
+#include "GeometricAsianPricer.hpp"
+#include "HubTestUtil.hpp"
+
+class AnalyticPricesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        optionData = TestOption();
+    }
+
+    OptionData optionData;
+};
+
+TEST_F(AnalyticPricesTest, BlackScholesValuesAndParity) {
+    EXPECT_NEAR(BlackScholesPrice(optionData), 10.450583572185565, 1e-12);
+    OptionData put = optionData;
+    put.type = -1;
+    EXPECT_NEAR(BlackScholesPrice(optionData) - BlackScholesPrice(put),
+                optionData.S_0 - optionData.K * std::exp(-optionData.r * optionData.T), 1e-12);
+}
+
+TEST_F(AnalyticPricesTest, GeometricAsianMatchesSimulation) {
+    const int NT = 12;
+    const double exact = GeometricAsianPrice(optionData, UniformAsianFixings(optionData.T, NT));
+    // Single fixing at t = 0 is the intrinsic value of S_0
+    EXPECT_NEAR(GeometricAsianPrice(optionData, {0.0}), 0.0, 1e-12);
+
+    auto payoff = MakePayoff(optionData);
+    const double df = std::exp(-optionData.r * optionData.T);
+    std::function<double()> discount = [df]() { return df; };
+    auto pricer = std::make_shared<GeometricAsianPricer>(payoff, discount);
+    const PricingRequest request{optionData, PayoffStyle::Asian, SchemeType::PredictorCorrector, NT, 40000, 8};
+    RunTestHub(request, pricer, 256);
+
+    const double se = df * std::get<1>(pricer->StandardDeviationStats());
+    EXPECT_NEAR(pricer->OptionPrice(), exact, 4.0 * se + 0.01);
+}
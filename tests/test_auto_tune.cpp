@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "AutoTune.hpp"
+#include "HubTestUtil.hpp"
+
+class AutoTuneTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory = "/tmp/mc_tune_test_" + std::to_string(::getpid());
+        std::filesystem::create_directories(directory);
+        // Tiny calibration so the suite stays fast
+        options.steps = 8;
+        options.paths = 512;
+        options.reps = 1;
+        options.maxWorkers = 2;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string File(const std::string& name) const { return directory + "/" + name; }
+
+    std::string directory;
+    AutoTuneOptions options;
+};
+
+TEST_F(AutoTuneTest, ProfileRoundTripsThroughItsFile) {
+    TuneProfile p;
+    p.host = "Some CPU @ 3.00GHz x8";
+    p.kernelBlockSize = 512;
+    p.rngBatch = 16;
+    p.precision = Precision::Single;
+    p.workers = 6;
+    p.pathsPerBlock = 8192;
+    p.stepsPerSecond = 1.5e8;
+    SaveTuneProfile(File("profile"), p);
+
+    const auto loaded = LoadTuneProfile(File("profile"));
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->host, p.host);
+    EXPECT_EQ(loaded->kernelBlockSize, 512u);
+    EXPECT_EQ(loaded->rngBatch, 16u);
+    EXPECT_EQ(loaded->precision, Precision::Single);
+    EXPECT_EQ(loaded->workers, 6u);
+    EXPECT_EQ(loaded->pathsPerBlock, 8192);
+    EXPECT_DOUBLE_EQ(loaded->stepsPerSecond, 1.5e8);
+
+    EXPECT_FALSE(LoadTuneProfile(File("missing")).has_value());
+    std::ofstream(File("garbage")) << "kernel_block_size lots\n";
+    EXPECT_THROW(LoadTuneProfile(File("garbage")), std::runtime_error);
+}
+
+TEST_F(AutoTuneTest, TunesOncePerHost) {
+    bool tuned = false;
+    const TuneProfile first = LoadOrTune(File("cache/profile"), options, &tuned);
+    EXPECT_TRUE(tuned);
+    EXPECT_EQ(first.host, HostFingerprint());
+    EXPECT_EQ(first.precision, Precision::Double);   // float32 not allowed by default
+    EXPECT_GE(first.workers, 1u);
+    EXPECT_LE(first.workers, 2u);
+    EXPECT_GT(first.stepsPerSecond, 0.0);
+
+    const TuneProfile second = LoadOrTune(File("cache/profile"), options, &tuned);
+    EXPECT_FALSE(tuned);
+    EXPECT_EQ(second.kernelBlockSize, first.kernelBlockSize);
+    EXPECT_EQ(second.rngBatch, first.rngBatch);
+
+    // A profile from another machine is replaced
+    TuneProfile other = first;
+    other.host = "another host";
+    SaveTuneProfile(File("cache/profile"), other);
+    EXPECT_EQ(LoadOrTune(File("cache/profile"), options, &tuned).host, HostFingerprint());
+    EXPECT_TRUE(tuned);
+}
+
+TEST_F(AutoTuneTest, RngBatchDoesNotChangeResults) {
+    PricingRequest request;
+    request.option = TestOption();
+    request.style = PayoffStyle::Asian;
+    request.NT = 10;
+    request.NSIM = 1000;
+
+    auto price = [&](size_t batch) {
+        auto pricer = MakePricer(request);
+        RunTestHub(request, pricer, 128, [batch](TestHub<>& hub) { hub.SetRngBatch(batch); });
+        return pricer->OptionPrice();
+    };
+    const double reference = price(1);
+    for (size_t batch : std::vector<size_t>{3, 4, 10, 64}) {
+        EXPECT_DOUBLE_EQ(price(batch), reference) << "batch " << batch;
+    }
+}
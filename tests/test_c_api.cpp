@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+#include "HubTestUtil.hpp"
+#include "JobScheduler.hpp"
+#include "montecarlo.h"
+
+namespace {
+
+// Heap allocations made on any thread while counting is on
+std::atomic<bool> countAllocations{false};
+std::atomic<long> allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (countAllocations) ++allocations;
+    if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, [[maybe_unused]] std::size_t size) noexcept {
+    std::free(p);
+}
+
+class CApiTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mc_engine_config cfg{2, 0, 1000};
+        ASSERT_EQ(mc_engine_create(&cfg, &engine), MC_OK);
+        ASSERT_NE(engine, nullptr);
+
+        // At-the-money call and put, European and Asian
+        for (int32_t style : {MC_STYLE_EUROPEAN, MC_STYLE_ASIAN}) {
+            for (int32_t type : {1, -1}) {
+                options.push_back(mc_option_spec{100.0, 1.0, 0.05, 0.2, 0.0, 100.0, 1.0, type, style});
+            }
+        }
+        params = mc_run_params{MC_SCHEME_PREDICTOR_CORRECTOR, 50, 4000, 17};
+    }
+
+    void TearDown() override {
+        mc_engine_destroy(engine);
+    }
+
+    mc_engine* engine{nullptr};
+    std::vector<mc_option_spec> options;
+    mc_run_params params{};
+};
+
+TEST_F(CApiTest, PricesABatchIntoCallerArrays) {
+    std::vector<mc_result> results(options.size());
+    ASSERT_EQ(mc_price_batch(engine, options.data(), options.size(), &params, 1, results.data()), MC_OK);
+    for (const auto& r : results) {
+        EXPECT_EQ(r.status, MC_STATUS_OK);
+        EXPECT_EQ(r.paths, params.NSIM);
+        EXPECT_GT(r.price, 0.0);
+        EXPECT_GT(r.stdErr, 0.0);
+    }
+    EXPECT_NEAR(results[0].price, 10.45, 5.0 * results[0].stdErr);
+
+    // Same seed on a reused engine reproduces the batch, and matches the C++ scheduler
+    std::vector<mc_result> again(options.size());
+    ASSERT_EQ(mc_price_batch(engine, options.data(), options.size(), &params, 1, again.data()), MC_OK);
+    EXPECT_DOUBLE_EQ(again[2].price, results[2].price);
+
+    JobScheduler scheduler(JobScheduler::Config{.workers = 1, .pathsPerBlock = 1000});
+    PricingRequest req;
+    req.option = TestOption();
+    req.NT = 50;
+    req.NSIM = 4000;
+    req.seed = 17;
+    EXPECT_DOUBLE_EQ(scheduler.Submit(req).get().result.price, results[0].price);
+}
+
+TEST_F(CApiTest, ReportsBadInputsWithoutThrowing) {
+    std::vector<mc_result> results(2);
+    std::vector<mc_run_params> perOption{params, params};
+    perOption[1].NSIM = 0;
+    std::vector<mc_option_spec> two{options[0], options[1]};
+    two[0].style = 7;
+    ASSERT_EQ(mc_price_batch(engine, two.data(), 2, perOption.data(), 2, results.data()), MC_OK);
+    EXPECT_EQ(results[0].status, MC_STATUS_BAD_REQUEST);
+    EXPECT_EQ(results[1].status, MC_STATUS_BAD_REQUEST);
+    EXPECT_STREQ(mc_status_string(results[0].status), "bad request");
+
+    EXPECT_EQ(mc_price_batch(engine, two.data(), 2, perOption.data(), 3, results.data()), MC_ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(mc_price_batch(nullptr, two.data(), 2, &params, 1, results.data()), MC_ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(mc_engine_create(nullptr, nullptr), MC_ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(mc_api_version(), static_cast<uint32_t>(MC_API_VERSION));
+}
+
+TEST_F(CApiTest, RepeatedBatchesDoNotAllocate) {
+    // One worker, so the warm-up batch has grown every hub the timed batch uses
+    mc_engine* single = nullptr;
+    mc_engine_config cfg{1, 0, 1000};
+    ASSERT_EQ(mc_engine_create(&cfg, &single), MC_OK);
+    std::vector<mc_result> results(options.size());
+    std::vector<mc_run_params> perOption(options.size(), params);
+    perOption[1].seed = 0;   // drawn from the engine's own seed stream
+    ASSERT_EQ(mc_price_batch(single, options.data(), options.size(), perOption.data(), perOption.size(),
+                             results.data()), MC_OK);
+
+    std::vector<mc_result> again(options.size());
+    allocations = 0;
+    countAllocations = true;
+    const int rc = mc_price_batch(single, options.data(), options.size(), perOption.data(), perOption.size(),
+                                  again.data());
+    countAllocations = false;
+    ASSERT_EQ(rc, MC_OK);
+    EXPECT_EQ(allocations.load(), 0);
+    for (size_t i = 0; i < options.size(); ++i) {
+        EXPECT_EQ(again[i].status, MC_STATUS_OK);
+        EXPECT_EQ(again[i].paths, params.NSIM);
+    }
+    // Seeded options repeat, results do not depend on the number of workers
+    EXPECT_EQ(again[0].price, results[0].price);
+    std::vector<mc_result> pooled(options.size());
+    ASSERT_EQ(mc_price_batch(engine, options.data(), options.size(), &params, 1, pooled.data()), MC_OK);
+    EXPECT_EQ(pooled[2].price, again[2].price);
+    mc_engine_destroy(single);
+}
+
+TEST(FixedSeedSeqTest, MatchesStdSeedSeq) {
+    std::seed_seq reference{1u, 2u, 0xDEADBEEFu, 7u, 0x5EEDu};
+    const FixedSeedSeq<5> fixed({1u, 2u, 0xDEADBEEFu, 7u, 0x5EEDu});
+    for (size_t n : {1u, 5u, 8u, 40u, 624u}) {
+        std::vector<std::uint32_t> a(n), b(n);
+        reference.generate(a.begin(), a.end());
+        fixed.generate(b.begin(), b.end());
+        EXPECT_EQ(a, b) << n << " words";
+    }
+}
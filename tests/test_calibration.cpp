@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "AnalyticPrices.hpp"
+#include "Calibration.hpp"
+#include "HubTestUtil.hpp"
+
+class CalibrationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        base = TestOption();
+        cfg.paths = 8000;
+        cfg.steps = 20;
+        cfg.seed = 17;
+    }
+
+    // Calls and puts across strikes and two maturities, priced by Black-Scholes at sig
+    std::vector<CalibrationInstrument> Market(double sig) const {
+        std::vector<CalibrationInstrument> out;
+        for (double T : {0.5, 1.0}) {
+            for (double K : {85.0, 100.0, 115.0}) {
+                CalibrationInstrument inst;
+                inst.option = base;
+                inst.option.T = T;
+                inst.option.K = K;
+                inst.option.type = K < 100.0 ? -1 : 1;
+                OptionData quoted = inst.option;
+                quoted.sig = sig;
+                inst.marketPrice = BlackScholesPrice(quoted);
+                out.push_back(inst);
+            }
+        }
+        return out;
+    }
+
+    OptionData base;
+    CalibrationConfig cfg;
+};
+
+TEST_F(CalibrationTest, PricesAreDeterministicAndSmoothInTheParameters) {
+    Calibrator calibrator(Market(0.2), VolatilityModel(0.2), cfg);
+    const auto a = calibrator.Prices({0.2});
+    const auto b = calibrator.Prices({0.2});
+    EXPECT_EQ(a, b);
+
+    // Common random numbers: a tiny bump gives a clean vega close to Black-Scholes
+    const double h = 1e-4;
+    const auto up = calibrator.Prices({0.2 + h});
+    const auto down = calibrator.Prices({0.2 - h});
+    OptionData atm = base;
+    atm.sig = 0.2 + h;
+    const double bsUp = BlackScholesPrice(atm);
+    atm.sig = 0.2 - h;
+    const double bsVega = (bsUp - BlackScholesPrice(atm)) / (2.0 * h);
+    const double mcVega = (up[4] - down[4]) / (2.0 * h);   // T = 1, K = 100
+    EXPECT_NEAR(mcVega, bsVega, 0.05 * bsVega);
+}
+
+TEST_F(CalibrationTest, RecoversVolatilityFromItsOwnPrices) {
+    auto instruments = Market(0.2);
+    Calibrator pricer(instruments, VolatilityModel(0.27), cfg);
+    const auto target = pricer.Prices({0.27});
+    for (size_t i = 0; i < instruments.size(); ++i) instruments[i].marketPrice = target[i];
+
+    Calibrator calibrator(instruments, VolatilityModel(0.12), cfg);
+    const CalibrationResult res = calibrator.Run();
+    EXPECT_TRUE(res.converged);
+    EXPECT_NEAR(res.params[0], 0.27, 1e-6);
+    EXPECT_LT(res.iterations, 15);
+    EXPECT_LT(res.cost, 1e-12);
+}
+
+TEST_F(CalibrationTest, FitsBlackScholesQuotesWithinSimulationError) {
+    Calibrator calibrator(Market(0.25), VolatilityModel(0.15), cfg);
+    const CalibrationResult res = calibrator.Run();
+    EXPECT_TRUE(res.converged);
+    EXPECT_NEAR(res.params[0], 0.25, 0.01);
+    EXPECT_EQ(res.modelPrices.size(), 6u);
+}
+
+TEST_F(CalibrationTest, FitsTwoParameterCEV) {
+    auto instruments = Market(0.2);
+    Calibrator pricer(instruments, CEVModel(0.2, 1.0), cfg);
+    // sig * S^(beta - 1) keeps the at-the-money vol near 0.25
+    const std::vector<double> truth{0.25 * std::pow(100.0, 0.3), 0.7};
+    const auto target = pricer.Prices(truth);
+    for (size_t i = 0; i < instruments.size(); ++i) instruments[i].marketPrice = target[i];
+
+    Calibrator calibrator(instruments, CEVModel(0.2, 1.0), cfg);
+    const CalibrationResult res = calibrator.Run();
+    EXPECT_NEAR(res.params[1], truth[1], 1e-3);
+    EXPECT_NEAR(res.params[0] / truth[0], 1.0, 1e-2);
+}
+
+TEST_F(CalibrationTest, RejectsPathByPathMode) {
+    cfg.blockSize = 0;
+    EXPECT_THROW(Calibrator(Market(0.2), VolatilityModel(0.2), cfg), std::runtime_error);
+}
+
+TEST_F(CalibrationTest, MappedNormalsMatchInMemoryNormals) {
+    const std::string file = "/tmp/mc_normals_test_" + std::to_string(::getpid());
+    const auto memory = NormalCache::InMemory(5, 1000);
+    const auto mapped = NormalCache::Mapped(file, 5, 1000);
+    EXPECT_TRUE(mapped->IsMapped());
+    ASSERT_EQ(mapped->Normals().size(), 1000u);
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(mapped->Normals()[i], memory->Normals()[i]);
+    }
+    // Reused while seed and length match, rewritten otherwise
+    const auto again = NormalCache::Mapped(file, 5, 1000);
+    EXPECT_EQ(again->Normals()[999], memory->Normals()[999]);
+    const auto other = NormalCache::Mapped(file, 6, 10);
+    EXPECT_EQ(other->Normals()[0], NormalCache::InMemory(6, 10)->Normals()[0]);
+    std::filesystem::remove(file);
+
+    CachedNormalGen gen(memory);
+    for (size_t i = 0; i < 1000; ++i) gen.GenerateRandNum();
+    EXPECT_THROW(gen.GenerateRandNum(), std::runtime_error);
+}
@@ -1,26 +1,18 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <cmath>
+#include "AnalyticPrices.hpp"
 #include "FDMEuler.hpp"
+#include "FDMLogEuler.hpp"
 #include "FDMPredictCorrect.hpp"
+#include "HubTestUtil.hpp"
 #include "SDEGeneral.hpp"
 #include "OptionData.hpp"
 
 class FDMTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        optionData = OptionData{
-            .K = 100.0,        // Strike price
-            .T = 1.0,          // Time to maturity
-            .r = 0.05,         // Risk-free rate
-            .sig = 0.2,        // Volatility
-            .D = 0.0,          // Dividend rate
-            .S_0 = 100.0,      // Initial stock price
-            .type = 1,         // Call option
-            .H = 0.0,          // No barrier
-            .betaCEV = 1.0,    // Standard CEV parameter
-            .scale = 1.0       // Standard scale
-        };
+        optionData = TestOption();
         
         drift = []([[maybe_unused]] double t, double S) { 
             return 0.05 * S; 
@@ -148,3 +140,79 @@ TEST_F(FDMTest, ZeroVolatilityCase) {
     const double expected = S0 * (1 + optionData.r * dt);
     EXPECT_NEAR(nextValue, expected, tolerance);
 }
+
+TEST_F(FDMTest, UniformGridMatchesLegacyConstruction) {
+    const int NT = 100;
+    const auto grid = TimeGrid::Uniform(optionData.T, NT);
+    auto fdm = std::make_shared<FDMEuler>(sde, grid);
+
+    EXPECT_EQ(fdm->getNumTimeSteps(), NT);
+    EXPECT_TRUE(fdm->getObservationIndices().empty());
+    for (size_t j = 0; j < static_cast<size_t>(NT); ++j) {
+        EXPECT_NEAR(fdm->getTimeStep(j), optionData.T / NT, tolerance);
+    }
+}
+
+TEST_F(FDMTest, FixingGridMarksObservationDates) {
+    // Quarterly fixings, no refinement: the grid is exactly the fixing dates
+    const auto grid = TimeGrid::FromFixings({0.25, 0.5, 0.75, 1.0}, optionData.T);
+    auto fdm = std::make_shared<FDMPredictCorrect>(sde, grid);
+
+    ASSERT_EQ(fdm->getNumTimeSteps(), 4);
+    EXPECT_EQ(fdm->getObservationIndices(), (std::vector<size_t>{1, 2, 3, 4}));
+    EXPECT_NEAR(fdm->getTimePoints().back(), optionData.T, tolerance);
+}
+
+TEST_F(FDMTest, FixingGridRefinementKeepsFixingsOnGrid) {
+    const std::vector<double> fixings{0.1, 0.6};
+    const double maxStep = 0.2;
+    const auto grid = TimeGrid::FromFixings(fixings, optionData.T, maxStep);
+    const auto& t = grid.Times();
+
+    for (double dt : grid.Steps()) {
+        EXPECT_LE(dt, maxStep + tolerance);
+    }
+    ASSERT_EQ(grid.ObservationIndices().size(), fixings.size());
+    for (size_t k = 0; k < fixings.size(); ++k) {
+        EXPECT_NEAR(t[grid.ObservationIndices()[k]], fixings[k], tolerance);
+    }
+    EXPECT_NEAR(t.back(), optionData.T, tolerance);
+}
+
+TEST_F(FDMTest, InvalidGridThrows) {
+    EXPECT_THROW(TimeGrid({0.0, 0.5, 0.5, 1.0}), std::runtime_error);
+    EXPECT_THROW(TimeGrid({0.1, 0.5}), std::runtime_error);
+    EXPECT_THROW(TimeGrid::FromFixings({1.5}, optionData.T), std::runtime_error);
+}
+
+TEST_F(FDMTest, HubRejectsStepCountOffTheGrid) {
+    std::shared_ptr<FDMType> fdm = std::make_shared<FDMEuler>(sde, TimeGrid::FromFixings({0.5, 1.0}, optionData.T));
+    PricingRequest request;
+    request.option = optionData;
+    auto pieces = std::make_tuple(sde, MakePricer(request), fdm, std::make_shared<MTEngRandNumGen>(1));
+    EXPECT_THROW((TestHub<>(pieces, 100, 100)), std::runtime_error);
+    EXPECT_NO_THROW((TestHub<>(pieces, 100, 2)));
+}
+
+TEST_F(FDMTest, LogEulerIsExactForGBMOnAMonthlyGrid) {
+    PricingRequest request;
+    request.option = optionData;
+    request.scheme = SchemeType::LogEuler;
+    request.NT = 12;
+    request.NSIM = 100000;
+    request.seed = 5;
+
+    // The batched kernel takes the same step as next_n
+    auto gbm = MakeSDE(optionData);
+    FDMLogEuler scheme(gbm, request.NT);
+    double block[2] = {100.0, 80.0};
+    const double z[2] = {0.3, -1.2};
+    scheme.next_block(block, z, 2, 0.0, 1.0 / 12.0);
+    EXPECT_NEAR(block[0], scheme.next_n(100.0, 0.0, 1.0 / 12.0, 0.3, 0.0), 1e-12);
+    EXPECT_NEAR(block[1], scheme.next_n(80.0, 0.0, 1.0 / 12.0, -1.2, 0.0), 1e-12);
+
+    auto pricer = MakePricer(request);
+    RunTestHub(request, pricer, 256);
+    const auto [sd, se] = pricer->StandardDeviationStats();
+    EXPECT_NEAR(pricer->OptionPrice(), BlackScholesPrice(optionData), 4.0 * se);
+}
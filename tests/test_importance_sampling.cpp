@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include "CompositePricer.hpp"
+#include "HubTestUtil.hpp"
+#include "ImportanceSampling.hpp"
+
+class ImportanceSamplingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.option.K = 160.0;
+        request.NT = 50;
+        request.NSIM = 20000;
+        request.seed = 21;
+    }
+
+    double BlackScholes() const {
+        const auto& o = request.option;
+        const double d1 = (std::log(o.S_0 / o.K) + (o.r + 0.5 * o.sig * o.sig) * o.T) / (o.sig * std::sqrt(o.T));
+        const double d2 = d1 - o.sig * std::sqrt(o.T);
+        auto N = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+        const double df = std::exp(-o.r * o.T);
+        if (o.type == -1) return o.K * df * N(-d2) - o.S_0 * N(-d1);
+        return o.S_0 * N(d1) - o.K * df * N(d2);
+    }
+
+    struct Estimate {
+        double price;
+        double se;
+    };
+
+    Estimate Run(double theta, size_t blockSize) {
+        auto pricer = MakePricer(request);
+        RunTestHub(request, pricer, blockSize, [theta](TestHub<>& hub) { hub.SetDriftShift(theta); });
+        const double df = std::exp(-request.option.r * request.option.T);
+        return {pricer->OptionPrice(), df * std::get<1>(pricer->StandardDeviationStats())};
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(ImportanceSamplingTest, ShiftedDeepOTMOptionsAreUnbiasedWithSmallerError) {
+    for (int type : {1, -1}) {
+        request.option.type = type;
+        request.option.K = type == 1 ? 160.0 : 60.0;
+        const double exact = BlackScholes();
+        auto rng = std::make_shared<MTEngRandNumGen>(3);
+        const double theta = ChooseDriftShift(request, rng, ImportanceSamplingConfig{});
+        EXPECT_GT(theta * type, 1.0);
+
+        for (SchemeType scheme : {SchemeType::Euler, SchemeType::PredictorCorrector}) {
+            request.scheme = scheme;
+            for (size_t blockSize : {size_t{0}, size_t{256}}) {
+                const Estimate plain = Run(0.0, blockSize);
+                const Estimate shifted = Run(theta, blockSize);
+                // Tolerance includes the Euler time-step bias far in the tail
+                EXPECT_NEAR(shifted.price, exact, 4.0 * shifted.se + 0.08 * exact);
+                EXPECT_LT(shifted.se, 0.2 * plain.se);
+            }
+        }
+    }
+}
+
+TEST_F(ImportanceSamplingTest, PilotRefinesTheAnalyticShift) {
+    auto sde = MakeSDE(request.option);
+    const double analytic = AnalyticDriftShift(*sde, request.option.K, 1);
+    // S_T at the shifted mode lies beyond the strike
+    const double a = (request.option.r - 0.5 * 0.04) * request.option.T;
+    EXPECT_GT(100.0 * std::exp(a + 0.2 * analytic * request.option.T), request.option.K);
+
+    auto rng = std::make_shared<MTEngRandNumGen>(4);
+    ImportanceSamplingConfig cfg;
+    const double pilot = ChooseDriftShift(request, rng, cfg);
+    EXPECT_NEAR(pilot, analytic, 0.5);
+
+    cfg.selection = ShiftSelection::Fixed;
+    cfg.shift = 0.75;
+    EXPECT_DOUBLE_EQ(ChooseDriftShift(request, rng, cfg), 0.75);
+}
+
+TEST_F(ImportanceSamplingTest, PilotMomentsComeFromPayoffsForAnyPricer) {
+    auto sde = MakeSDE(request.option);
+    auto fdm = MakeFDM(sde, request.scheme, request.NT);
+    ImportanceSamplingConfig cfg;
+    cfg.pilotIterations = 1;
+
+    // Starting unshifted, and through a composite that keeps no accumulators itself
+    const double plain = PilotDriftShift(sde, fdm, [this] { return MakePricer(request); },
+                                         std::make_shared<MTEngRandNumGen>(9), 0.0, cfg);
+    const double book = PilotDriftShift(sde, fdm, [this] {
+        return std::make_shared<CompositePricer>(std::vector<std::shared_ptr<Pricer>>{MakePricer(request)});
+    }, std::make_shared<MTEngRandNumGen>(9), 0.0, cfg);
+    EXPECT_GT(plain, 1.0);
+    EXPECT_DOUBLE_EQ(book, plain);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "HubTestUtil.hpp"
+#include "IncrementalRepricer.hpp"
+#include "PricingEngine.hpp"
+
+class IncrementalRepricerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        base.option = TestOption();
+        base.scheme = SchemeType::Euler;
+        base.NT = 12;
+        base.NSIM = 3000;
+        base.seed = 5;
+        rng = std::make_shared<MTEngRandNumGen>();
+    }
+
+    // Full simulation on the same seed for comparison
+    PricingResult FullRun(double spot, double strike, int type, PayoffStyle style) {
+        auto req = base;
+        req.option.S_0 = spot;
+        req.option.K = strike;
+        req.option.type = type;
+        req.style = style;
+        return PriceBatch({req}, rng)[0];
+    }
+
+    PricingRequest base;
+    std::shared_ptr<MTEngRandNumGen> rng;
+};
+
+TEST_F(IncrementalRepricerTest, MatchesFullRunsOnSpotAndStrikeLadders) {
+    const auto repricer = IncrementalRepricer::FromSimulation(base, rng);
+    ASSERT_EQ(repricer.NumPaths(), static_cast<size_t>(base.NSIM));
+
+    for (PayoffStyle style : {PayoffStyle::European, PayoffStyle::Asian}) {
+        for (int type : {1, -1}) {
+            for (double spot : {80.0, 100.0, 125.0}) {
+                for (double strike : {90.0, 100.0, 115.0}) {
+                    const auto fast = repricer.Reprice(spot, strike, type, style);
+                    const auto full = FullRun(spot, strike, type, style);
+                    EXPECT_NEAR(fast.price, full.price, 1e-9 * (1.0 + full.price));
+                    EXPECT_NEAR(fast.stdDev, full.stdDev, 1e-6 * (1.0 + full.stdDev));
+                    EXPECT_EQ(fast.paths, full.paths);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(IncrementalRepricerTest, LaddersAreMonotone) {
+    const auto repricer = IncrementalRepricer::FromSimulation(base, rng);
+    const auto calls = repricer.StrikeLadder(100.0, {80.0, 90.0, 100.0, 110.0, 120.0}, 1, PayoffStyle::European);
+    for (size_t i = 1; i < calls.size(); ++i) {
+        EXPECT_LT(calls[i].price, calls[i - 1].price);
+    }
+    const auto puts = repricer.SpotLadder({80.0, 90.0, 100.0, 110.0}, 100.0, -1, PayoffStyle::Asian);
+    for (size_t i = 1; i < puts.size(); ++i) {
+        EXPECT_LT(puts[i].price, puts[i - 1].price);
+    }
+}
+
+TEST_F(IncrementalRepricerTest, RejectsNonScaleInvariantSDE) {
+    base.option.betaCEV = 0.5;
+    EXPECT_THROW(IncrementalRepricer::FromSimulation(base, rng), std::runtime_error);
+}
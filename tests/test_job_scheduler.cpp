@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "HubTestUtil.hpp"
+#include "JobScheduler.hpp"
+
+class JobSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::Euler;
+        request.NT = 10;
+        request.NSIM = 5000;
+        request.seed = 99;
+    }
+
+    static JobScheduler::Config Workers(unsigned n) {
+        JobScheduler::Config cfg;
+        cfg.workers = n;
+        cfg.pathsPerBlock = 512;
+        return cfg;
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(JobSchedulerTest, ResultIndependentOfWorkerCount) {
+    JobResult one, three;
+    {
+        JobScheduler scheduler(Workers(1));
+        one = scheduler.Submit(request).get();
+    }
+    {
+        JobScheduler scheduler(Workers(3));
+        three = scheduler.Submit(request).get();
+    }
+    EXPECT_EQ(one.result.status, PricingStatus::Ok);
+    EXPECT_EQ(one.result.paths, request.NSIM);
+    EXPECT_DOUBLE_EQ(one.result.price, three.result.price);
+    EXPECT_DOUBLE_EQ(one.result.stdErr, three.result.stdErr);
+}
+
+TEST_F(JobSchedulerTest, PricesABookWithCallbacks) {
+    JobScheduler scheduler(Workers(2));
+    std::atomic<int> callbacks{0};
+    std::vector<std::future<JobResult>> futures;
+    for (int type : {1, -1}) {
+        for (PayoffStyle style : {PayoffStyle::European, PayoffStyle::Asian}) {
+            auto req = request;
+            req.option.type = type;
+            req.style = style;
+            futures.push_back(scheduler.Submit(req, [&](const JobResult&) { ++callbacks; }));
+        }
+    }
+    for (auto& f : futures) {
+        const auto res = f.get();
+        EXPECT_EQ(res.result.status, PricingStatus::Ok);
+        EXPECT_GT(res.result.price, 0.0);
+    }
+    scheduler.WaitIdle();
+    EXPECT_EQ(callbacks.load(), 4);
+}
+
+TEST_F(JobSchedulerTest, SmallJobDoesNotWaitBehindLargeJob) {
+    JobScheduler scheduler(Workers(1));
+    std::mutex mtx;
+    std::vector<std::uint64_t> order;
+    auto record = [&](const JobResult& r) {
+        std::lock_guard<std::mutex> lock(mtx);
+        order.push_back(r.jobId);
+    };
+
+    auto large = request;
+    large.NSIM = 200 * 512;
+    auto small = request;
+    small.NSIM = 512;
+    auto largeFut = scheduler.Submit(large, record);
+    auto smallFut = scheduler.Submit(small, record);
+
+    const auto smallRes = smallFut.get();
+    const auto largeRes = largeFut.get();
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order.front(), smallRes.jobId);
+    EXPECT_LT(smallRes.seconds, largeRes.seconds);
+}
+
+TEST_F(JobSchedulerTest, InvalidJobFailsImmediately) {
+    JobScheduler scheduler(Workers(1));
+    auto bad = request;
+    bad.NSIM = 0;
+    EXPECT_EQ(scheduler.Submit(bad).get().result.status, PricingStatus::BadRequest);
+
+    // Its callback is delivered on the pool like any other
+    std::thread::id callbackThread;
+    scheduler.Submit(bad, [&](const JobResult&) { callbackThread = std::this_thread::get_id(); }).get();
+    EXPECT_NE(callbackThread, std::thread::id{});
+    EXPECT_NE(callbackThread, std::this_thread::get_id());
+}
+
+TEST_F(JobSchedulerTest, PinnedWorkersGiveTheSameResult) {
+    JobResult unpinned, pinned;
+    {
+        JobScheduler scheduler(Workers(2));
+        unpinned = scheduler.Submit(request).get();
+    }
+    {
+        auto cfg = Workers(2);
+        cfg.pinWorkers = true;
+        JobScheduler scheduler(cfg);
+        pinned = scheduler.Submit(request).get();
+        for (int cpu : scheduler.WorkerCpus()) {
+            if (cpu >= 0) {
+                EXPECT_GE(scheduler.Topology().NodeOfCpu(cpu), 0);
+            }
+        }
+    }
+    EXPECT_DOUBLE_EQ(unpinned.result.price, pinned.result.price);
+}
+
+TEST(NumaTopologyTest, ParsesCpuListsAndSpreadsWorkers) {
+    EXPECT_EQ(NumaTopology::ParseCpuList("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+
+    NumaTopology topo({NumaNode{0, {0, 1}}, NumaNode{1, {2, 3}}});
+    EXPECT_EQ(topo.SpreadPlacement(5), (std::vector<int>{0, 2, 1, 3, 0}));
+    EXPECT_EQ(topo.NodeOfCpu(3), 1);
+    EXPECT_EQ(topo.NodeOfCpu(9), -1);
+
+    const NumaTopology host = NumaTopology::Detect();
+    EXPECT_GE(host.Nodes().size(), 1u);
+    EXPECT_GE(host.NumCpus(), 1u);
+}
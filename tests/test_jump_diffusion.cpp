@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "AnalyticPrices.hpp"
+#include "HubTestUtil.hpp"
+#include "JumpDiffusion.hpp"
+
+class JumpDiffusionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.option.D = 0.02;
+        request.scheme = SchemeType::PredictorCorrector;
+        request.NT = 50;
+        request.NSIM = 100000;
+        request.seed = 44;
+    }
+
+    // Price and undiscounted SE of a European on the jump diffusion
+    std::pair<double, double> Simulate(const JumpCoefficients& jumps, size_t blockSize = 256) {
+        auto pricer = MakePricer(request);
+        RunTestHub(request, pricer, blockSize, {}, {.sde = MakeJumpDiffusionSDE(request.option, jumps)});
+        return {pricer->OptionPrice(), std::get<1>(pricer->StandardDeviationStats())};
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(JumpDiffusionTest, MertonSeriesReducesToBlackScholesAndKeepsParity) {
+    const auto none = JumpCoefficients::Merton(0.0, -0.1, 0.15);
+    EXPECT_NEAR(MertonJumpPrice(request.option, none), BlackScholesPrice(request.option), 1e-12);
+
+    const auto jumps = JumpCoefficients::Merton(1.5, -0.1, 0.15);
+    OptionData put = request.option;
+    put.type = -1;
+    const OptionData& o = request.option;
+    EXPECT_NEAR(MertonJumpPrice(o, jumps) - MertonJumpPrice(put, jumps),
+                o.S_0 * std::exp(-o.D * o.T) - o.K * std::exp(-o.r * o.T), 1e-10);
+    // Jumps add variance: more time value than the diffusion alone
+    EXPECT_GT(MertonJumpPrice(o, jumps), BlackScholesPrice(o));
+}
+
+TEST_F(JumpDiffusionTest, SampledJumpsArePoissonOnTheGrid) {
+    const auto jumps = JumpCoefficients::Merton(2.0, 0.0, 0.1);
+    const std::vector<double> times = TimeGrid::Uniform(1.0, 10).Times();
+    MTEngRandNumGen rng(5);
+    std::vector<JumpEvent> events;
+    const size_t paths = 20000;
+    SampleJumps(jumps, times, paths, rng, events);
+
+    // Poisson(2) counts: mean 2, standard error sqrt(2 / paths)
+    const double mean = static_cast<double>(events.size()) / static_cast<double>(paths);
+    EXPECT_NEAR(mean, 2.0, 5.0 * std::sqrt(2.0 / static_cast<double>(paths)));
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const JumpEvent& a, const JumpEvent& b) {
+        return a.step != b.step ? a.step < b.step : a.path < b.path;
+    }));
+    for (const auto& e : events) {
+        ASSERT_LT(e.step, times.size() - 1);
+        ASSERT_LT(e.path, paths);
+        ASSERT_GE(e.frac, 0.0);
+        ASSERT_LE(e.frac, 1.0);
+    }
+}
+
+TEST_F(JumpDiffusionTest, MertonSimulationMatchesSeries) {
+    for (int type : {1, -1}) {
+        request.option.type = type;
+        const auto jumps = JumpCoefficients::Merton(1.0, -0.15, 0.2);
+        const double exact = MertonJumpPrice(request.option, jumps);
+        const double df = std::exp(-request.option.r * request.option.T);
+
+        const auto [block, blockSE] = Simulate(jumps);
+        EXPECT_NEAR(block, exact, 4.0 * df * blockSE + 0.02) << "type " << type;
+
+        request.NSIM = 20000;
+        const auto [pathByPath, pathSE] = Simulate(jumps, 0);
+        EXPECT_NEAR(pathByPath, exact, 4.0 * df * pathSE + 0.02) << "type " << type;
+        request.NSIM = 100000;
+    }
+}
+
+TEST_F(JumpDiffusionTest, KouSimulationIsAMartingale) {
+    // Zero strike: the call pays S_T, worth S_0 e^{-DT} once jumps are compensated
+    request.option.K = 0.0;
+    const auto jumps = JumpCoefficients::Kou(3.0, 0.4, 10.0, 5.0);
+    const auto [price, se] = Simulate(jumps);
+    const double df = std::exp(-request.option.r * request.option.T);
+    EXPECT_NEAR(price, request.option.S_0 * std::exp(-request.option.D * request.option.T),
+                4.0 * df * se + 0.02);
+}
+
+TEST_F(JumpDiffusionTest, ZeroIntensityMatchesDiffusion) {
+    request.NSIM = 5000;
+    const auto [withJumps, jumpSE] = Simulate(JumpCoefficients::Merton(0.0, 0.0, 0.1));
+
+    auto pricer = MakePricer(request);
+    RunTestHub(request, pricer, 256);
+    EXPECT_DOUBLE_EQ(withJumps, pricer->OptionPrice());
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "HubTestUtil.hpp"
+#include "LocalVolSurface.hpp"
+#include "PricingEngine.hpp"
+
+class LocalVolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        optionData = TestOption();
+        optionData.r = 0.03;
+        std::vector<double> times{0.0, 0.25, 0.5, 1.0};
+        std::vector<double> spots;
+        for (int j = 0; j <= 40; ++j) spots.push_back(40.0 + 4.0 * j);
+        // Skewed surface flattening in time
+        surface = std::make_shared<LocalVolSurface>(LocalVolSurface::FromFunction(times, spots,
+            [](double t, double S) { return 0.2 + 0.1 * (100.0 - S) / 100.0 * std::exp(-t); }));
+    }
+
+    OptionData optionData;
+    std::shared_ptr<LocalVolSurface> surface;
+};
+
+TEST_F(LocalVolTest, BilinearLookupWithFlatExtrapolation) {
+    const LocalVolSurface grid({0.0, 1.0}, {90.0, 110.0}, {0.1, 0.3, 0.2, 0.4});
+    EXPECT_DOUBLE_EQ(grid.Vol(0.0, 90.0), 0.1);
+    EXPECT_DOUBLE_EQ(grid.Vol(1.0, 110.0), 0.4);
+    EXPECT_NEAR(grid.Vol(0.5, 100.0), 0.25, 1e-15);
+    EXPECT_DOUBLE_EQ(grid.Vol(-1.0, 50.0), 0.1);
+    EXPECT_DOUBLE_EQ(grid.Vol(2.0, 500.0), 0.4);
+
+    double slope = 0.0;
+    grid.Vol(0.5, 95.0, &slope);
+    EXPECT_NEAR(slope, 0.01, 1e-15);
+
+    EXPECT_THROW(LocalVolSurface({0.0, 0.0}, {1.0}, {0.1, 0.1}), std::runtime_error);
+    EXPECT_THROW(LocalVolSurface({0.0}, {1.0, 2.0}, {0.1}), std::runtime_error);
+}
+
+TEST_F(LocalVolTest, HintedSliceLookupMatchesDirectLookup) {
+    std::mt19937_64 gen(3);
+    std::normal_distribution<double> move(0.0, 3.0);
+    std::vector<double> S(64, 100.0), out(64), level, slope;
+    std::vector<std::uint32_t> hints(64, 0);
+    for (double t : {0.1, 0.3, 0.7, 2.0}) {
+        surface->SliceAt(t, level, slope);
+        for (int step = 0; step < 20; ++step) {
+            for (double& s : S) s = std::max(1.0, s + move(gen) * 4.0);
+            surface->VolBlock(level.data(), slope.data(), S.data(), S.size(), hints.data(), out.data());
+            for (size_t k = 0; k < S.size(); ++k) {
+                EXPECT_NEAR(out[k], surface->Vol(t, S[k]), 1e-14);
+            }
+        }
+    }
+}
+
+TEST_F(LocalVolTest, BlockKernelsMatchScalarSchemes) {
+    auto sde = MakeLocalVolSDE(optionData, surface);
+    for (SchemeType scheme : {SchemeType::Euler, SchemeType::PredictorCorrector}) {
+        auto fdm = MakeFDM(sde, scheme, 50);
+        std::vector<double> xs{30.0, 80.0, 99.0, 100.0, 101.0, 150.0, 300.0};
+        std::vector<double> zs{0.3, -1.2, 0.0, 2.0, -0.4, 1.1, -2.5};
+        std::vector<double> block = xs;
+        fdm->next_block(block.data(), zs.data(), xs.size(), 0.3, 0.02);
+        for (size_t k = 0; k < xs.size(); ++k) {
+            EXPECT_NEAR(block[k], fdm->next_n(xs[k], 0.3, 0.02, zs[k], 0.0), 1e-12 * xs[k]);
+        }
+    }
+}
+
+TEST_F(LocalVolTest, FlatSurfaceReproducesGBM) {
+    auto flat = std::make_shared<LocalVolSurface>(std::vector<double>{0.0}, std::vector<double>{100.0},
+                                                  std::vector<double>{optionData.sig});
+    PricingRequest request{optionData, PayoffStyle::European, SchemeType::Euler, 50, 20000, 11};
+
+    auto price = [&](std::shared_ptr<SDEGeneral> sde) {
+        auto pricer = MakePricer(request);
+        RunTestHub(request, pricer, 256, {}, {.sde = std::move(sde)});
+        return pricer->OptionPrice();
+    };
+    const double gbm = price(MakeSDE(optionData));
+    EXPECT_NEAR(price(MakeLocalVolSDE(optionData, flat)), gbm, 1e-9 * gbm);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include "EuropeanOptionPricer.hpp"
+#include "AsianOptionPricer.hpp"
+#include "HubTestUtil.hpp"
+
+class MixedPrecisionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        optionData = TestOption();
+        optionData.T = 0.25;
+        payoffCall = [](double s) { return std::max<double>(0.0, s - 100.0); };
+        discount = []() { return std::exp(-0.05 * 0.25); };
+    }
+
+    struct Estimate {
+        double price;
+        double se;
+    };
+
+    template <typename PricerType>
+    Estimate Run(SchemeType scheme, Precision precision, size_t blockSize, std::uint64_t seed) {
+        auto pricer = std::make_shared<PricerType>(payoffCall, discount);
+        const PricingRequest request{optionData, PayoffStyle::European, scheme, NT, NSIM, seed};
+        RunTestHub(request, pricer, blockSize, [precision](TestHub<>& hub) { hub.SetPrecision(precision); });
+        return {pricer->OptionPrice(), std::get<1>(pricer->StandardDeviationStats()) * discount()};
+    }
+
+    OptionData optionData;
+    std::function<double(double)> payoffCall;
+    std::function<double()> discount;
+    static constexpr int NT = 50;
+    static constexpr int NSIM = 20000;
+};
+
+TEST_F(MixedPrecisionTest, BlockKernelsMatchScalarSchemes) {
+    // beta = 0.8 exercises the pow branch of the kernels
+    for (double beta : {1.0, 0.8}) {
+        optionData.betaCEV = beta;
+        auto sde = MakeSDE(optionData);
+        for (SchemeType scheme : {SchemeType::Euler, SchemeType::PredictorCorrector}) {
+            auto fdm = MakeFDM(sde, scheme, NT);
+            double xs[3] = {80.0, 100.0, 130.0};
+            const double zs[3] = {-1.5, 0.1, 2.0};
+            double expected[3];
+            for (int k = 0; k < 3; ++k) {
+                expected[k] = fdm->next_n(xs[k], 0.1, 0.01, zs[k], 0.0);
+            }
+            fdm->next_block(xs, zs, 3, 0.1, 0.01);
+            for (int k = 0; k < 3; ++k) {
+                EXPECT_NEAR(xs[k], expected[k], 1e-10);
+            }
+        }
+    }
+}
+
+TEST_F(MixedPrecisionTest, SinglePrecisionEuropeanWithinStandardError) {
+    for (SchemeType scheme : {SchemeType::Euler, SchemeType::PredictorCorrector}) {
+        const auto ref = Run<EuropeanOptionPricer>(scheme, Precision::Double, 0, 101);
+        const auto single = Run<EuropeanOptionPricer>(scheme, Precision::Single, 256, 202);
+        EXPECT_NEAR(single.price, ref.price, 4.0 * std::hypot(ref.se, single.se));
+    }
+}
+
+TEST_F(MixedPrecisionTest, SinglePrecisionAsianWithinStandardError) {
+    const auto ref = Run<AsianOptionPricer>(SchemeType::PredictorCorrector, Precision::Double, 0, 303);
+    const auto single = Run<AsianOptionPricer>(SchemeType::PredictorCorrector, Precision::Single, 128, 404);
+    EXPECT_NEAR(single.price, ref.price, 4.0 * std::hypot(ref.se, single.se));
+}
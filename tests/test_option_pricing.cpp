@@ -4,24 +4,14 @@
 #include <numeric>
 #include "EuropeanOptionPricer.hpp"
 #include "AsianOptionPricer.hpp"
+#include "HubTestUtil.hpp"
 #include "OptionData.hpp"
 
 class OptionPricingTest : public ::testing::Test {
 protected:
     void SetUp() override {
         // Initialize all fields of OptionData
-        optionData = OptionData{
-            .K = 100.0,        // Strike
-            .T = 1.0,          // Time to maturity
-            .r = 0.05,         // Risk-free rate
-            .sig = 0.2,        // Volatility
-            .D = 0.0,          // Dividend
-            .S_0 = 100.0,      // Initial price
-            .type = 1,         // Call option
-            .H = 0.0,          // No barrier
-            .betaCEV = 1.0,    // Standard CEV parameter
-            .scale = 1.0       // Standard scale
-        };
+        optionData = TestOption();
         
         payoffCall = std::function<double(double)>([](double s) { 
             return std::max<double>(0.0, s - 100.0); 
@@ -123,6 +113,17 @@ TEST_F(OptionPricingTest, AsianPutTest) {
     EXPECT_NEAR(pricer->OptionPrice(), expected_payoff * std::exp(-0.05), tolerance);
 }
 
+TEST_F(OptionPricingTest, AsianAveragesObservationDatesOnly) {
+    auto pricer = std::make_shared<AsianOptionPricer>(payoffCall, discount);
+    pricer->SetObservationIndices({2, 4});
+    std::vector<double> path = {100.0, 90.0, 110.0, 95.0, 130.0};
+    pricer->GeneratePath(path);
+    pricer->AfterPathCleanUp();
+
+    const double expected_payoff = (110.0 + 130.0) / 2.0 - optionData.K;
+    EXPECT_NEAR(pricer->OptionPrice(), expected_payoff * std::exp(-0.05), tolerance);
+}
+
 TEST_F(OptionPricingTest, DiscountFactorTest) {
     auto pricer = std::make_shared<EuropeanOptionPricer>(payoffCall, discount);
     EXPECT_NEAR(pricer->DiscountFactor(), std::exp(-0.05), tolerance);
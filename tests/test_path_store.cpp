@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "EuropeanOptionPricer.hpp"
+#include "AsianOptionPricer.hpp"
+#include "FDMEuler.hpp"
+#include "HubTestUtil.hpp"
+#include "PathStore.hpp"
+#include "PricingEngine.hpp"
+
+class PathStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        optionData = TestOption();
+        payoffCall = [](double s) { return std::max<double>(0.0, s - 100.0); };
+        payoffPut = [](double s) { return std::max<double>(0.0, 90.0 - s); };
+        discount = []() { return std::exp(-0.05); };
+        fileName = "/tmp/mc_path_store_test_" + std::to_string(::getpid()) + ".bin";
+    }
+
+    void TearDown() override {
+        ::unlink(fileName.c_str());
+    }
+
+    // Simulates NSIM paths on a fixing grid into the store, returns the live pricer
+    std::shared_ptr<Pricer> SimulateToStore(Precision precision) {
+        auto sde = MakeSDE(optionData);
+        auto grid = TimeGrid::FromFixings({0.25, 0.5, 0.75, 1.0}, optionData.T, 0.05);
+        std::shared_ptr<FDMType> fdm = std::make_shared<FDMEuler>(sde, grid);
+        std::shared_ptr<Pricer> pricer = std::make_shared<AsianOptionPricer>(payoffCall, discount);
+
+        auto writer = std::make_shared<PathStoreWriter>(
+            fileName, MakePathStoreInfo(optionData, *fdm, SchemeType::Euler, 7u), precision);
+        const PricingRequest request{optionData, PayoffStyle::Asian, SchemeType::Euler, grid.NumSteps(), NSIM, 7u};
+        RunTestHub(request, pricer, 0, [&](TestHub<>& hub) { hub.AttachPathWriter(writer); },
+                   {.sde = sde, .fdm = fdm});
+        writer->Close();
+        return pricer;
+    }
+
+    OptionData optionData;
+    std::function<double(double)> payoffCall;
+    std::function<double(double)> payoffPut;
+    std::function<double()> discount;
+    std::string fileName;
+    static constexpr int NSIM = 500;
+};
+
+TEST_F(PathStoreTest, ReplayReproducesLivePrice) {
+    const auto live = SimulateToStore(Precision::Double);
+
+    PathStoreReader store(fileName);
+    EXPECT_EQ(store.NumPaths(), static_cast<std::uint64_t>(NSIM));
+    EXPECT_EQ(store.Info().seed, 7u);
+    EXPECT_EQ(store.Info().observations.size(), 4u);
+    EXPECT_DOUBLE_EQ(store.Info().option.sig, optionData.sig);
+
+    AsianOptionPricer replayed(payoffCall, discount);
+    ReplayPaths(store, replayed);
+    EXPECT_DOUBLE_EQ(replayed.OptionPrice(), live->OptionPrice());
+    EXPECT_EQ(replayed.PathCount(), NSIM);
+}
+
+TEST_F(PathStoreTest, PriceNewPayoffWithoutResimulating) {
+    SimulateToStore(Precision::Double);
+    PathStoreReader store(fileName);
+
+    EuropeanOptionPricer put(payoffPut, discount);
+    ReplayPaths(store, put);
+    EXPECT_EQ(put.PathCount(), NSIM);
+    EXPECT_GT(put.OptionPrice(), 0.0);
+}
+
+TEST_F(PathStoreTest, SinglePrecisionStoreIsClose) {
+    const auto live = SimulateToStore(Precision::Single);
+
+    PathStoreReader store(fileName);
+    EXPECT_EQ(store.GetPrecision(), Precision::Single);
+    AsianOptionPricer replayed(payoffCall, discount);
+    ReplayPaths(store, replayed);
+    EXPECT_NEAR(replayed.OptionPrice(), live->OptionPrice(), 1e-4);
+}
+
+TEST_F(PathStoreTest, RejectsMissingOrCorruptFile) {
+    EXPECT_THROW(PathStoreReader("/nonexistent/path_store.bin"), std::runtime_error);
+
+    std::FILE* f = std::fopen(fileName.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    const char junk[256] = {};
+    std::fwrite(junk, 1, sizeof(junk), f);
+    std::fclose(f);
+    EXPECT_THROW(PathStoreReader{fileName}, std::runtime_error);
+}
+
+TEST_F(PathStoreTest, RejectsOutOfRangeHeaderFields) {
+    SimulateToStore(Precision::Double);
+    const auto patch = [this](long offset, std::uint64_t value) {
+        std::FILE* f = std::fopen(fileName.c_str(), "r+b");
+        ASSERT_NE(f, nullptr);
+        std::fseek(f, offset, SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, f);
+        std::fclose(f);
+    };
+    std::uint64_t pathSize = 0;
+    {
+        PathStoreReader reader(fileName);
+        pathSize = reader.PathSize();
+        ASSERT_FALSE(reader.Info().observations.empty());
+    }
+
+    // First observation index points past the end of each path
+    const long firstObservation = static_cast<long>(sizeof(PathStoreHeader) + pathSize * sizeof(double));
+    patch(firstObservation, pathSize);
+    EXPECT_THROW(PathStoreReader{fileName}, std::runtime_error);
+
+    // A path count whose byte size wraps around 64 bits
+    SimulateToStore(Precision::Double);
+    patch(static_cast<long>(offsetof(PathStoreHeader, numPaths)), std::uint64_t{1} << 61);
+    EXPECT_THROW(PathStoreReader{fileName}, std::runtime_error);
+}
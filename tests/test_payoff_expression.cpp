@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <span>
+#include <vector>
+#include "HubTestUtil.hpp"
+#include "PayoffExpression.hpp"
+
+using namespace payoff;
+
+class PayoffExpressionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::PredictorCorrector;
+        request.NT = 50;
+        request.NSIM = 4000;
+        request.seed = 31;
+    }
+
+    // Block-mode run of one pricer on the request's seed
+    void Run(std::shared_ptr<Pricer> pricer, Precision precision = Precision::Double) {
+        RunTestHub(request, std::move(pricer), 128, [precision](TestHub<>& hub) { hub.SetPrecision(precision); });
+    }
+
+    double Discount() const { return std::exp(-request.option.r * request.option.T); }
+
+    PricingRequest request;
+};
+
+TEST_F(PayoffExpressionTest, PrimitivesOnAStoredPath) {
+    const std::vector<double> path{100.0, 120.0, 90.0, 110.0};
+    EXPECT_DOUBLE_EQ(Evaluate(Terminal(), path), 110.0);
+    EXPECT_DOUBLE_EQ(Evaluate(Average(), path), 310.0 / 3.0);
+    EXPECT_DOUBLE_EQ(Evaluate(Average(), path, {1, 3}), 115.0);
+    EXPECT_DOUBLE_EQ(Evaluate(PathMax() - PathMin(), path), 30.0);
+    EXPECT_DOUBLE_EQ(Evaluate(HitBelow(95.0) + 2.0 * HitAbove(130.0), path), 1.0);
+    EXPECT_DOUBLE_EQ(Evaluate(Min(Max(Terminal() - 100.0, 0.0), 5.0), path), 5.0);
+    EXPECT_DOUBLE_EQ(Evaluate(-(Terminal() / 2.0), path), -55.0);
+
+    // An empty path after a real one leaves nothing to average
+    auto pricer = MakeExpressionPricer(Average(), 1.0);
+    pricer->GeneratePath(path);
+    pricer->GeneratePath(std::span<const double>{});
+    EXPECT_EQ(pricer->PathCount(), 2);
+}
+
+TEST_F(PayoffExpressionTest, StreamingMatchesPathPricers) {
+    auto european = MakePricer(request);
+    auto europeanExpr = MakeExpressionPricer(Max(Terminal() - 100.0, 0.0), Discount());
+    Run(european);
+    Run(europeanExpr);
+    EXPECT_DOUBLE_EQ(europeanExpr->OptionPrice(), european->OptionPrice());
+
+    request.style = PayoffStyle::Asian;
+    auto asian = MakePricer(request);
+    auto asianExpr = MakeExpressionPricer(Max(Average() - 100.0, 0.0), Discount());
+    Run(asian);
+    Run(asianExpr);
+    EXPECT_NEAR(asianExpr->OptionPrice(), asian->OptionPrice(), 1e-12);
+}
+
+TEST_F(PayoffExpressionTest, PathDependentPayoffsAgreeWithStoredPaths) {
+    auto lookback = PathMax() - Terminal();
+    auto barrierAsian = (1.0 - HitBelow(85.0)) * Min(Max(Average() - 100.0, 0.0), 20.0);
+
+    // Streamed directly vs built from whole paths through a composite
+    auto streamedLookback = MakeExpressionPricer(lookback, Discount());
+    auto streamedBarrier = MakeExpressionPricer(barrierAsian, Discount());
+    Run(streamedLookback);
+    Run(streamedBarrier);
+
+    auto storedLookback = MakeExpressionPricer(lookback, Discount());
+    auto storedBarrier = MakeExpressionPricer(barrierAsian, Discount());
+    Run(std::make_shared<CompositePricer>(std::vector<std::shared_ptr<Pricer>>{storedLookback, storedBarrier}));
+
+    EXPECT_NEAR(streamedLookback->OptionPrice(), storedLookback->OptionPrice(), 1e-12);
+    EXPECT_NEAR(streamedBarrier->OptionPrice(), storedBarrier->OptionPrice(), 1e-12);
+    EXPECT_GT(streamedLookback->OptionPrice(), 0.0);
+
+    // Knock-out and cap only remove value from the plain Asian
+    request.style = PayoffStyle::Asian;
+    auto asian = MakePricer(request);
+    Run(asian);
+    EXPECT_LT(streamedBarrier->OptionPrice(), asian->OptionPrice());
+}
+
+TEST_F(PayoffExpressionTest, StreamsSinglePrecisionBlocks) {
+    auto expr = MakeExpressionPricer(Max(Terminal() - 100.0, 0.0), Discount());
+    auto european = MakePricer(request);
+    Run(expr, Precision::Single);
+    Run(european, Precision::Single);
+    EXPECT_NEAR(expr->OptionPrice(), european->OptionPrice(), 1e-9);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "AnalyticPrices.hpp"
+#include "HubTestUtil.hpp"
+#include "JobScheduler.hpp"
+#include "PDESolver.hpp"
+#include "PricingEngine.hpp"
+
+class PDESolverTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        optionData = TestOption();
+        optionData.D = 0.02;
+    }
+
+    PDEResult Solve(const OptionData& o, const PDEConfig& cfg = {}) {
+        return SolvePDE(*MakeSDE(o), MakePayoff(o), cfg);
+    }
+
+    // Continuously monitored down-and-out call with H <= K (Hull, no rebate)
+    static double DownAndOutCall(const OptionData& o) {
+        const double sqT = o.sig * std::sqrt(o.T);
+        const double lambda = (o.r - o.D + 0.5 * o.sig * o.sig) / (o.sig * o.sig);
+        const double y = std::log(o.H * o.H / (o.S_0 * o.K)) / sqT + lambda * sqT;
+        const double ratio = o.H / o.S_0;
+        const double downIn = o.S_0 * std::exp(-o.D * o.T) * std::pow(ratio, 2.0 * lambda) * NormalCDF(y)
+            - o.K * std::exp(-o.r * o.T) * std::pow(ratio, 2.0 * lambda - 2.0) * NormalCDF(y - sqT);
+        return BlackScholesPrice(o) - downIn;
+    }
+
+    OptionData optionData;
+};
+
+TEST_F(PDESolverTest, ThomasSolvesTridiagonalSystem) {
+    const std::vector<double> lower{0.0, -1.0, -1.0, -1.0};
+    const std::vector<double> diag{4.0, 4.0, 4.0, 4.0};
+    const std::vector<double> upper{-1.0, -1.0, -1.0, 0.0};
+    const std::vector<double> expected{1.0, -2.0, 3.0, 0.5};
+    std::vector<double> d(4);
+    for (size_t i = 0; i < 4; ++i) {
+        d[i] = diag[i] * expected[i];
+        if (i > 0) d[i] += lower[i] * expected[i - 1];
+        if (i < 3) d[i] += upper[i] * expected[i + 1];
+    }
+    std::vector<double> x;
+    std::vector<double> scratch;
+    SolveTridiagonal(lower, diag, upper, d, x, scratch);
+    for (size_t i = 0; i < 4; ++i) EXPECT_NEAR(x[i], expected[i], 1e-14);
+}
+
+TEST_F(PDESolverTest, EuropeanMatchesBlackScholesWithGreeks) {
+    for (int type : {1, -1}) {
+        OptionData o = optionData;
+        o.type = type;
+        const PDEResult res = Solve(o);
+        EXPECT_NEAR(res.price, BlackScholesPrice(o), 2e-3) << "type " << type;
+
+        // Greeks of the closed form by central differences
+        const double dS = 1e-3;
+        OptionData up = o;
+        OptionData down = o;
+        up.S_0 += dS;
+        down.S_0 -= dS;
+        const double bsUp = BlackScholesPrice(up);
+        const double bsDown = BlackScholesPrice(down);
+        EXPECT_NEAR(res.delta, (bsUp - bsDown) / (2.0 * dS), 1e-3);
+        EXPECT_NEAR(res.gamma, (bsUp - 2.0 * BlackScholesPrice(o) + bsDown) / (dS * dS), 1e-3);
+
+        const double dT = 1e-4;
+        OptionData shorter = o;
+        shorter.T -= dT;
+        EXPECT_NEAR(res.theta, (BlackScholesPrice(o) - BlackScholesPrice(shorter)) / -dT, 2e-2);
+    }
+}
+
+TEST_F(PDESolverTest, RannacherStartRemovesGammaRinging) {
+    // Few time steps on a fine grid: pure Crank-Nicolson oscillates at the kink
+    OptionData o = optionData;
+    o.T = 0.05;
+    PDEConfig cfg;
+    cfg.spaceSteps = 800;
+    cfg.timeSteps = 10;
+
+    const PDEResult smoothed = Solve(o, cfg);
+    cfg.rannacherSteps = 0;
+    const PDEResult raw = Solve(o, cfg);
+
+    OptionData up = o;
+    OptionData down = o;
+    up.S_0 += 1e-3;
+    down.S_0 -= 1e-3;
+    const double gamma = (BlackScholesPrice(up) - 2.0 * BlackScholesPrice(o) + BlackScholesPrice(down)) / 1e-6;
+    EXPECT_NEAR(smoothed.gamma, gamma, 0.02 * gamma);
+    EXPECT_GT(std::abs(raw.gamma - gamma), std::abs(smoothed.gamma - gamma));
+}
+
+TEST_F(PDESolverTest, AmericanPutByPenaltyAndPSOR) {
+    OptionData o = optionData;
+    o.type = -1;
+    o.D = 0.0;
+    PDEConfig cfg;
+    cfg.exercise = ExerciseStyle::American;
+    const PDEResult penalty = Solve(o, cfg);
+    cfg.method = EarlyExercise::PSOR;
+    const PDEResult psor = Solve(o, cfg);
+
+    // Binomial reference for S = K = 100, r = 5%, sig = 20%, T = 1
+    EXPECT_NEAR(penalty.price, 6.0903, 5e-3);
+    EXPECT_NEAR(psor.price, penalty.price, 1e-4);
+    EXPECT_GT(penalty.price, BlackScholesPrice(o) + 0.1);
+    EXPECT_GT(penalty.exerciseIterations, 0);
+    // Deep in the money it is exercised: V = K - S
+    EXPECT_NEAR(penalty.ValueAt(60.0), 40.0, 1e-6);
+}
+
+TEST_F(PDESolverTest, DownAndOutCallMatchesClosedForm) {
+    OptionData o = optionData;
+    o.H = 90.0;
+    const PDEResult res = Solve(o);
+    EXPECT_NEAR(res.price, DownAndOutCall(o), 5e-3);
+    EXPECT_LT(res.price, BlackScholesPrice(o));
+    EXPECT_DOUBLE_EQ(res.values.front(), 0.0);
+
+    o.S_0 = 85.0;
+    EXPECT_EQ(Solve(o).price, 0.0);
+}
+
+TEST_F(PDESolverTest, SchedulerRoutesEuropeanRequestsToPDE) {
+    JobScheduler::Config cfg;
+    cfg.workers = 1;
+    cfg.routePDE = true;
+    JobScheduler scheduler(cfg);
+
+    const PricingRequest european{optionData, PayoffStyle::European, SchemeType::Euler, 50, 1000, 7};
+    std::thread::id callbackThread;
+    const JobResult routed = scheduler.Submit(european, [&](const JobResult&) {
+        callbackThread = std::this_thread::get_id();
+    }).get();
+    EXPECT_NE(callbackThread, std::this_thread::get_id());
+    EXPECT_EQ(routed.result.status, PricingStatus::Ok);
+    EXPECT_EQ(routed.result.paths, 0);
+    EXPECT_NEAR(routed.result.price, BlackScholesPrice(optionData), 2e-3);
+
+    // Path-dependent payoffs still simulate
+    PricingRequest asian = european;
+    asian.style = PayoffStyle::Asian;
+    EXPECT_FALSE(PDEEligible(asian));
+    EXPECT_EQ(scheduler.Submit(asian).get().result.paths, 1000);
+}
+
+TEST_F(PDESolverTest, RoutingDoesNotTurnBarrierRequestsIntoKnockOuts) {
+    JobScheduler::Config routedCfg;
+    routedCfg.workers = 1;
+    routedCfg.routePDE = true;
+    JobScheduler routed(routedCfg);
+    JobScheduler::Config simulatedCfg;
+    simulatedCfg.workers = 1;
+    JobScheduler simulated(simulatedCfg);
+
+    for (double H : {90.0, 120.0}) {
+        OptionData o = optionData;
+        o.H = H;
+        const PricingRequest req{o, PayoffStyle::European, SchemeType::Euler, 50, 4000, 7};
+        EXPECT_FALSE(PDEEligible(req));
+        EXPECT_EQ(PricePDE(req).status, PricingStatus::BadRequest);
+
+        const PricingResult a = routed.Submit(req).get().result;
+        const PricingResult b = simulated.Submit(req).get().result;
+        EXPECT_EQ(a.status, PricingStatus::Ok);
+        EXPECT_EQ(a.paths, 4000);
+        EXPECT_DOUBLE_EQ(a.price, b.price);
+        EXPECT_GT(a.price, 0.0);
+    }
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "HubTestUtil.hpp"
+#include "JobScheduler.hpp"
+#include "PerfCounters.hpp"
+#include "PricingEngine.hpp"
+
+class PerfCountersTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::PredictorCorrector;
+        request.NT = 40;
+        request.NSIM = 3000;
+        request.seed = 23;
+    }
+
+    double Run(std::shared_ptr<PerfProfile> profile, size_t rngBatch = 1) {
+        auto pricer = MakePricer(request);
+        RunTestHub(request, pricer, 128, [&](TestHub<>& hub) {
+            hub.SetRngBatch(rngBatch);
+            hub.AttachProfile(std::move(profile));
+        });
+        return pricer->OptionPrice();
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(PerfCountersTest, ProfiledBlockRunSplitsPhasesWithoutChangingResults) {
+    auto profile = std::make_shared<PerfProfile>();
+    EXPECT_DOUBLE_EQ(Run(profile), Run(nullptr));
+
+    const auto phases = profile->PhaseTotals();
+    ASSERT_EQ(phases.size(), 3u);
+    for (const auto& p : phases) {
+        EXPECT_EQ(p.paths, request.NSIM);
+        EXPECT_EQ(p.steps, request.NSIM * request.NT);
+        EXPECT_GT(p.counters.seconds, 0.0);
+        if (ThreadPerfCounters().Available()) {
+            EXPECT_GT(p.counters[PerfEvent::Instructions], 0u);
+        }
+    }
+    const std::string report = profile->Report();
+    EXPECT_NE(report.find("rng"), std::string::npos);
+    EXPECT_NE(report.find("price"), std::string::npos);
+}
+
+TEST_F(PerfCountersTest, ProfilingKeepsTheRngBatching) {
+    // 40 steps in batches of 7: the last draw covers 5 steps
+    auto profile = std::make_shared<PerfProfile>();
+    EXPECT_DOUBLE_EQ(Run(profile, 7), Run(nullptr, 7));
+    EXPECT_DOUBLE_EQ(Run(nullptr, 7), Run(nullptr, 1));
+
+    for (const auto& p : profile->PhaseTotals()) {
+        EXPECT_EQ(p.paths, request.NSIM) << p.phase;
+        EXPECT_EQ(p.steps, request.NSIM * request.NT) << p.phase;
+    }
+}
+
+TEST_F(PerfCountersTest, SampleDeltasDropEventsMissingOnEitherSide) {
+    PerfSample a, b;
+    a.values = {100, 200, 5, 1};
+    a.valid = {true, true, true, false};
+    a.seconds = 1.0;
+    b.values = {150, 260, 5, 3};
+    b.valid = {true, false, true, true};
+    b.seconds = 1.5;
+
+    const PerfSample d = b - a;
+    EXPECT_TRUE(d.Has(PerfEvent::Cycles));
+    EXPECT_EQ(d[PerfEvent::Cycles], 50u);
+    EXPECT_FALSE(d.Has(PerfEvent::Instructions));
+    EXPECT_FALSE(d.Has(PerfEvent::LLCMisses));
+    EXPECT_DOUBLE_EQ(d.seconds, 0.5);
+}
+
+TEST_F(PerfCountersTest, SchedulerRecordsPerWorkerThreads) {
+    JobScheduler::Config cfg;
+    cfg.workers = 2;
+    cfg.pathsPerBlock = 500;
+    cfg.kernelBlockSize = 128;
+    cfg.profile = std::make_shared<PerfProfile>();
+    {
+        JobScheduler scheduler(cfg);
+        scheduler.Submit(request).get();
+    }
+
+    std::int64_t pricedPaths = 0;
+    for (const auto& e : cfg.profile->Entries()) {
+        EXPECT_LT(e.thread, 2u);
+        if (e.phase == "price") pricedPaths += e.paths;
+    }
+    EXPECT_EQ(pricedPaths, request.NSIM);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include "HubTestUtil.hpp"
+#include "PricingEngine.hpp"
+#include "PricingService.hpp"
+
+class PricingServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.style = PayoffStyle::European;
+        request.scheme = SchemeType::Euler;
+        request.NT = 20;
+        request.NSIM = 4000;
+        request.seed = 42;
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(PricingServiceTest, WireRoundTrip) {
+    PricingRequest decoded;
+    ASSERT_TRUE(DecodeRequest(EncodeRequest(request), decoded));
+    EXPECT_TRUE(SameUnderlying(decoded, request));
+    EXPECT_EQ(decoded.option.K, request.option.K);
+    EXPECT_EQ(decoded.option.type, request.option.type);
+
+    WireRequest bad = EncodeRequest(request);
+    bad.magic = 0;
+    EXPECT_FALSE(DecodeRequest(bad, decoded));
+}
+
+TEST_F(PricingServiceTest, BatchMatchesSingleRunWithSameSeed) {
+    auto put = request;
+    put.option.type = -1;
+
+    auto rng = std::make_shared<MTEngRandNumGen>();
+    const auto single = PriceBatch({request}, rng);
+    const auto batch = PriceBatch({request, put}, rng);
+
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0].status, PricingStatus::Ok);
+    EXPECT_DOUBLE_EQ(batch[0].price, single[0].price);
+    EXPECT_EQ(batch[1].paths, request.NSIM);
+
+    // Put-call parity holds pathwise up to the discretisation of S_T
+    const double parity = request.option.S_0 - request.option.K * std::exp(-request.option.r);
+    EXPECT_NEAR(batch[0].price - batch[1].price, parity, 4.0 * (batch[0].stdErr + batch[1].stdErr));
+}
+
+TEST_F(PricingServiceTest, InvalidRequestIsRejected) {
+    auto bad = request;
+    bad.NT = 0;
+    auto rng = std::make_shared<MTEngRandNumGen>();
+    EXPECT_EQ(PriceBatch({bad}, rng)[0].status, PricingStatus::BadRequest);
+
+    bad.NT = MaxRequestSteps + 1;
+    EXPECT_EQ(PriceBatch({bad}, rng)[0].status, PricingStatus::BadRequest);
+
+    bad = request;
+    bad.option.r = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(PriceBatch({bad}, rng)[0].status, PricingStatus::BadRequest);
+    bad = request;
+    bad.option.D = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(PriceBatch({bad}, rng)[0].status, PricingStatus::BadRequest);
+
+    // The service caps the paths a single request may ask for
+    PricingService service(PricingService::Config{});
+    service.Start();
+    bad = request;
+    bad.NSIM = MaxRequestPaths + 1;
+    EXPECT_EQ(service.Submit(bad).get().status, PricingStatus::BadRequest);
+}
+
+TEST_F(PricingServiceTest, EachRequestIsLookedUpInTheCacheOnce) {
+    PricingService::Config cfg;
+    cfg.workers = 1;
+    cfg.cache = std::make_shared<ResultCache>();
+    PricingService service(cfg);
+    service.Start();
+
+    const PricingResult first = service.Submit(request).get();      // miss, simulated
+    const PricingResult repeat = service.Submit(request).get();     // full hit in Submit
+    auto more = request;
+    more.NSIM = 2 * request.NSIM;
+    const PricingResult topUp = service.Submit(more).get();         // partial hit, topped up
+    EXPECT_EQ(repeat.price, first.price);
+    EXPECT_EQ(topUp.paths, more.NSIM);
+    EXPECT_EQ(cfg.cache->Misses(), 1u);
+    EXPECT_EQ(cfg.cache->Hits(), 2u);
+    EXPECT_EQ(service.SimulationsRun(), 2u);
+}
+
+TEST_F(PricingServiceTest, ConcurrentRequestsAreCoalesced) {
+    PricingService::Config cfg;
+    cfg.workers = 1;
+    cfg.coalesceWindow = std::chrono::milliseconds(20);
+    PricingService service(cfg);
+    service.Start();
+
+    // Keep the only worker busy so the strikes below queue up behind it
+    auto blocker = request;
+    blocker.option.S_0 = 95.0;
+    blocker.NSIM = 150000;
+    auto blocked = service.Submit(blocker);
+
+    std::vector<std::future<PricingResult>> futures;
+    for (double K : {90.0, 100.0, 110.0}) {
+        auto req = request;
+        req.option.K = K;
+        futures.push_back(service.Submit(req));
+    }
+    std::vector<double> prices;
+    for (auto& f : futures) {
+        const auto res = f.get();
+        EXPECT_EQ(res.status, PricingStatus::Ok);
+        prices.push_back(res.price);
+    }
+    EXPECT_EQ(blocked.get().status, PricingStatus::Ok);
+    EXPECT_EQ(service.SimulationsRun(), 2u);
+    EXPECT_GT(prices[0], prices[1]);
+    EXPECT_GT(prices[1], prices[2]);
+}
+
+TEST_F(PricingServiceTest, SocketRoundTrip) {
+    PricingService::Config cfg;
+    cfg.socketPath = "/tmp/mc_pricing_test_" + std::to_string(::getpid()) + ".sock";
+    cfg.workers = 2;
+    PricingService service(cfg);
+    service.Start();
+
+    PricingClient client(cfg.socketPath);
+    auto asian = request;
+    asian.style = PayoffStyle::Asian;
+    const auto results = client.PriceAll({request, asian});
+
+    ASSERT_EQ(results.size(), 2u);
+    for (const auto& res : results) {
+        EXPECT_EQ(res.status, PricingStatus::Ok);
+        EXPECT_EQ(res.paths, request.NSIM);
+        EXPECT_GT(res.price, 0.0);
+    }
+    // Averaging lowers the call value
+    EXPECT_LT(results[1].price, results[0].price);
+}
+
+TEST_F(PricingServiceTest, ClosedConnectionsAreReaped) {
+    PricingService::Config cfg;
+    cfg.socketPath = "/tmp/mc_pricing_reap_" + std::to_string(::getpid()) + ".sock";
+    cfg.workers = 2;
+    PricingService service(cfg);
+    service.Start();
+
+    auto small = request;
+    small.NSIM = 200;
+    for (int i = 0; i < 40; ++i) {
+        PricingClient client(cfg.socketPath);
+        EXPECT_EQ(client.Price(small).status, PricingStatus::Ok);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (service.ConnectionCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(service.ConnectionCount(), 0u);
+    EXPECT_EQ(service.RequestsServed(), 40u);
+}
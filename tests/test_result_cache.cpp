@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <filesystem>
+#include <string>
+#include "HubTestUtil.hpp"
+#include "ResultCache.hpp"
+#include "PricingEngine.hpp"
+
+class ResultCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::Euler;
+        request.NT = 10;
+        request.NSIM = 2000;
+        request.seed = 11;
+        rng = std::make_shared<MTEngRandNumGen>();
+        directory = "/tmp/mc_result_cache_test_" + std::to_string(::getpid());
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    PricingRequest request;
+    std::shared_ptr<MTEngRandNumGen> rng;
+    std::string directory;
+};
+
+TEST_F(ResultCacheTest, KeyIgnoresPathCountAndSignOfZero) {
+    auto more = request;
+    more.NSIM = 10 * request.NSIM;
+    EXPECT_EQ(ResultCache::Hash(request), ResultCache::Hash(more));
+
+    auto negZero = request;
+    negZero.option.D = -0.0;
+    EXPECT_EQ(ResultCache::Hash(request), ResultCache::Hash(negZero));
+
+    auto otherStrike = request;
+    otherStrike.option.K = 101.0;
+    EXPECT_NE(ResultCache::Hash(request), ResultCache::Hash(otherStrike));
+}
+
+TEST_F(ResultCacheTest, RepeatedRequestIsServedFromCache) {
+    ResultCache cache;
+    const auto first = PriceBatchCached({request}, rng, cache);
+    const auto second = PriceBatchCached({request}, rng, cache);
+
+    EXPECT_EQ(cache.Hits(), 1u);
+    EXPECT_DOUBLE_EQ(first[0].price, second[0].price);
+    EXPECT_DOUBLE_EQ(first[0].stdErr, second[0].stdErr);
+    EXPECT_EQ(second[0].paths, request.NSIM);
+}
+
+TEST_F(ResultCacheTest, TopUpMergesExtraPaths) {
+    ResultCache cache;
+    const auto small = PriceBatchCached({request}, rng, cache);
+
+    auto bigger = request;
+    bigger.NSIM = 3 * request.NSIM;
+    const auto merged = PriceBatchCached({bigger}, rng, cache);
+
+    EXPECT_EQ(merged[0].paths, bigger.NSIM);
+    EXPECT_LT(merged[0].stdErr, small[0].stdErr);
+
+    // The merged entry equals the cached paths plus the top-up run on its own stream
+    auto extra = request;
+    extra.NSIM = bigger.NSIM - request.NSIM;
+    extra.seed = TopUpSeed(request.seed, request.NSIM);
+    std::vector<PathStatistics> base, topUp;
+    PriceBatch({request}, rng, &base);
+    PriceBatch({extra}, rng, &topUp);
+    base[0].Merge(topUp[0]);
+    EXPECT_NEAR(merged[0].price, base[0].Price(std::exp(-0.05)), 1e-12);
+}
+
+TEST_F(ResultCacheTest, PersistentTierSurvivesRestart) {
+    double price = 0.0;
+    {
+        ResultCache cache(16, directory);
+        price = PriceBatchCached({request}, rng, cache)[0].price;
+    }
+    ResultCache reopened(16, directory);
+    const auto entry = reopened.Lookup(request);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_DOUBLE_EQ(entry->Result().price, price);
+    EXPECT_EQ(entry->stats.count, request.NSIM);
+}
+
+TEST_F(ResultCacheTest, SeedZeroBypassesTheCache) {
+    ResultCache cache(16, directory);
+    auto unseeded = request;
+    unseeded.seed = 0;
+    const auto first = PriceBatchCached({unseeded}, rng, cache);
+    const auto second = PriceBatchCached({unseeded}, rng, cache);
+
+    // Each call continues the stream, so the two estimates use different paths
+    EXPECT_NE(first[0].price, second[0].price);
+    EXPECT_EQ(cache.Size(), 0u);
+    EXPECT_EQ(cache.Hits() + cache.Misses(), 0u);
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+}
+
+TEST_F(ResultCacheTest, EvictsLeastRecentlyUsed) {
+    ResultCache cache(2);
+    CacheEntry entry;
+    entry.stats.Add(1.0);
+    for (double K : {90.0, 100.0, 110.0}) {
+        auto req = request;
+        req.option.K = K;
+        cache.Store(req, entry);
+    }
+    EXPECT_EQ(cache.Size(), 2u);
+    auto oldest = request;
+    oldest.option.K = 90.0;
+    EXPECT_FALSE(cache.Lookup(oldest).has_value());
+}
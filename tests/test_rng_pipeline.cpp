@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include "HubTestUtil.hpp"
+#include "NormalCache.hpp"
+#include "PricingEngine.hpp"
+#include "RngPipeline.hpp"
+
+class RngPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        optionData = TestOption();
+        optionData.T = 0.5;
+    }
+
+    struct Run {
+        double price;
+        std::int64_t paths;
+        RngPipelineStats stats;
+    };
+
+    template <typename RNG>
+    Run Price(std::shared_ptr<RNG> rng, std::optional<RngPipelineConfig> pipeline, Precision precision,
+              double driftShift = 0.0, std::shared_ptr<SimulationControl> control = nullptr) {
+        const PricingRequest req{optionData, PayoffStyle::European, SchemeType::PredictorCorrector, NT, NSIM, 0};
+        std::shared_ptr<Pricer> pricer = MakePricer(req);
+        const auto hub = RunTestHub<RNG>(req, pricer, 128, [&](TestHub<RNG>& h) {
+            h.SetPrecision(precision);
+            h.SetDriftShift(driftShift);
+            h.SetRngPipeline(pipeline);
+            h.AttachControl(control);
+        }, {.rng = std::move(rng)});
+        return {pricer->OptionPrice(), hub->PathsSimulated(), hub->PipelineStats()};
+    }
+
+    OptionData optionData;
+    static constexpr int NT = 20;
+    static constexpr int NSIM = 5000;   // not a multiple of the block size
+};
+
+TEST_F(RngPipelineTest, RingHandsChunksOverInOrderWithBackPressure) {
+    SpscChunkRing<int> ring(2, 3);
+    constexpr int chunks = 2000;
+    std::thread producer([&] {
+        for (int c = 0; c < chunks; ++c) {
+            int* slot = ring.AcquireWrite();
+            ASSERT_NE(slot, nullptr);
+            for (int i = 0; i < 3; ++i) slot[i] = 3 * c + i;
+            ring.CommitWrite();
+        }
+    });
+    int expected = 0;
+    for (int c = 0; c < chunks; ++c) {
+        const int* slot = ring.AcquireRead();
+        ASSERT_NE(slot, nullptr);
+        for (int i = 0; i < 3; ++i) EXPECT_EQ(slot[i], expected++);
+        ring.ReleaseRead();
+    }
+    producer.join();
+
+    // Closed and drained: the reader gets nullptr, a writer is released
+    ring.Close();
+    EXPECT_EQ(ring.AcquireRead(), nullptr);
+    EXPECT_EQ(ring.AcquireWrite(), nullptr);
+}
+
+TEST_F(RngPipelineTest, PipelinedRunsMatchInlineGeneration) {
+    RngPipelineConfig cfg;
+    cfg.chunkBytes = 4096;   // several steps per chunk, many chunks per run
+    cfg.slots = 3;
+    for (Precision precision : {Precision::Double, Precision::Single}) {
+        for (double shift : {0.0, 0.3}) {
+            const Run inlineRun = Price(std::make_shared<MTEngRandNumGen>(42), std::nullopt, precision, shift);
+            const Run piped = Price(std::make_shared<MTEngRandNumGen>(42), cfg, precision, shift);
+            EXPECT_EQ(piped.price, inlineRun.price);
+            EXPECT_EQ(piped.paths, NSIM);
+            EXPECT_GT(piped.stats.chunks, 1u);
+        }
+    }
+}
+
+TEST_F(RngPipelineTest, ProducerFailureReachesTheCaller) {
+    // Too few cached normals: the producer throws part way through the run
+    auto cache = NormalCache::InMemory(1, static_cast<size_t>(NSIM) * NT / 2);
+    EXPECT_THROW(Price(std::make_shared<CachedNormalGen>(cache), RngPipelineConfig{}, Precision::Double),
+                 std::runtime_error);
+}
+
+TEST_F(RngPipelineTest, StoppedRunReleasesTheProducer) {
+    auto control = std::make_shared<SimulationControl>();
+    control->Cancel();
+    RngPipelineConfig cfg;
+    cfg.slots = 1;
+    const Run stopped = Price(std::make_shared<MTEngRandNumGen>(7), cfg, Precision::Double, 0.0, control);
+    EXPECT_EQ(stopped.paths, 0);
+}
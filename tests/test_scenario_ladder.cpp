@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include "AnalyticPrices.hpp"
+#include "HubTestUtil.hpp"
+#include "ScenarioLadder.hpp"
+
+class ScenarioLadderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::PredictorCorrector;
+        request.NT = 50;
+        request.NSIM = 20000;
+        request.seed = 17;
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(ScenarioLadderTest, UnbumpedScenarioMatchesHubRun) {
+    auto rng = std::make_shared<MTEngRandNumGen>();
+    const auto ladder = PriceScenarioLadder(request, ScenarioGrid{{-0.05, 0.0, 0.05}, {}}, rng, 128);
+    ASSERT_EQ(ladder.size(), 3u);
+
+    auto pricer = MakePricer(request);
+    RunTestHub(request, pricer, 128);
+
+    EXPECT_DOUBLE_EQ(ladder[1].result.price, pricer->OptionPrice());
+    EXPECT_EQ(ladder[1].result.paths, request.NSIM);
+    EXPECT_LT(ladder[0].result.price, ladder[1].result.price);
+    EXPECT_LT(ladder[1].result.price, ladder[2].result.price);
+}
+
+TEST_F(ScenarioLadderTest, CommonRandomNumbersGiveSmoothGreeks) {
+    const double h = 0.01;
+    auto rng = std::make_shared<MTEngRandNumGen>();
+    const auto ladder = PriceScenarioLadder(request, ScenarioGrid{{-h, 0.0, h}, {-h, 0.0, h}}, rng);
+    ASSERT_EQ(ladder.size(), 9u);
+
+    // Spot-major: (spot i, vol j) at i * 3 + j
+    const double dS = 2.0 * h * request.option.S_0;
+    const double delta = (ladder[7].result.price - ladder[1].result.price) / dS;
+    const double vega = (ladder[5].result.price - ladder[3].result.price) / (2.0 * h);
+    EXPECT_DOUBLE_EQ(ladder[5].vol, request.option.sig + h);
+
+    // Black-Scholes: N(d1) and S phi(d1) sqrt(T); independent runs with this
+    // many paths would put ~0.07 of noise on delta and ~7 on vega
+    const OptionData& o = request.option;
+    const double d1 = (std::log(o.S_0 / o.K) + (o.r + 0.5 * o.sig * o.sig) * o.T) / (o.sig * std::sqrt(o.T));
+    const double phi = std::exp(-0.5 * d1 * d1) / std::sqrt(2.0 * std::numbers::pi);
+    EXPECT_NEAR(delta, NormalCDF(d1), 0.03);
+    EXPECT_NEAR(vega, o.S_0 * phi * std::sqrt(o.T), 2.0);
+}
+
+TEST_F(ScenarioLadderTest, RejectsInvalidBumps) {
+    auto rng = std::make_shared<MTEngRandNumGen>();
+    EXPECT_THROW(PriceScenarioLadder(request, ScenarioGrid{{}, {-0.5}}, rng), std::runtime_error);
+    EXPECT_THROW(PriceScenarioLadder(request, ScenarioGrid{{-1.0}, {}}, rng), std::runtime_error);
+}
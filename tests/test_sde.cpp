@@ -1,22 +1,12 @@
 #include <gtest/gtest.h>
+#include "HubTestUtil.hpp"
 #include "SDEGeneral.hpp"
 #include "OptionData.hpp"
 
 class SDETest : public ::testing::Test {
 protected:
     void SetUp() override {
-        optionData = OptionData{
-            .K = 100.0,        // Strike price
-            .T = 1.0,          // Time to maturity
-            .r = 0.05,         // Risk-free rate
-            .sig = 0.2,        // Volatility
-            .D = 0.0,          // Dividend rate
-            .S_0 = 100.0,      // Initial stock price
-            .type = 1,         // Call option
-            .H = 0.0,          // No barrier
-            .betaCEV = 1.0,    // Standard CEV parameter
-            .scale = 1.0       // Standard scale
-        };
+        optionData = TestOption();
         
         // muS
         drift = []([[maybe_unused]] double t, double S) { 
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <filesystem>
+#include <string>
+#include "HubTestUtil.hpp"
+#include "JobScheduler.hpp"
+#include "PricingEngine.hpp"
+#include "ShardRun.hpp"
+
+class ShardRunTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::Euler;
+        request.NT = 20;
+        request.NSIM = 10000;
+        request.seed = 29;
+        cfg.pathsPerBlock = 1000;
+        directory = "/tmp/mc_shard_test_" + std::to_string(::getpid());
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string File(const std::string& name) const { return directory + "/" + name; }
+
+    PricingRequest request;
+    ShardRunConfig cfg;
+    std::string directory;
+};
+
+TEST_F(ShardRunTest, ShardSpecParsesAndPartitionsBlocks) {
+    const ShardSpec spec = ShardSpec::Parse("2/3");
+    EXPECT_EQ(spec.index, 2u);
+    EXPECT_EQ(spec.count, 3u);
+    EXPECT_THROW(ShardSpec::Parse("3/3"), std::runtime_error);
+    EXPECT_THROW(ShardSpec::Parse("1-3"), std::runtime_error);
+    EXPECT_THROW(ShardSpec::Parse("1/3x"), std::runtime_error);
+
+    std::int64_t next = 0;
+    for (std::uint64_t i = 0; i < 7; ++i) {
+        const auto [first, last] = ShardSpec{i, 7}.BlockRange(45);
+        EXPECT_EQ(first, next);
+        next = last;
+    }
+    EXPECT_EQ(next, 45);
+}
+
+TEST_F(ShardRunTest, MergedShardsMatchSingleRunAndScheduler) {
+    std::vector<std::string> files;
+    for (std::uint64_t i = 0; i < 3; ++i) {
+        files.push_back(File("shard_" + std::to_string(i)));
+        EXPECT_TRUE(RunShard(request, ShardSpec{i, 3}, files.back(), cfg).Complete());
+    }
+    const ShardMerge merged = MergeShardFiles(files);
+    const ShardState single = RunShard(request, ShardSpec{}, File("single"), cfg);
+
+    EXPECT_EQ(merged.result.status, PricingStatus::Ok);
+    EXPECT_EQ(merged.result.paths, request.NSIM);
+    EXPECT_NEAR(merged.stats.sum, single.stats.sum, 1e-9 * single.stats.sum);
+
+    JobScheduler::Config schedCfg;
+    schedCfg.workers = 2;
+    schedCfg.pathsPerBlock = cfg.pathsPerBlock;
+    schedCfg.kernelBlockSize = cfg.kernelBlockSize;
+    JobScheduler scheduler(schedCfg);
+    const JobResult job = scheduler.Submit(request).get();
+    EXPECT_NEAR(merged.result.price, job.result.price, 1e-9 * job.result.price);
+}
+
+TEST_F(ShardRunTest, MatchesSchedulerOnlyWithTheSameKernelBlockSize) {
+    JobScheduler::Config schedCfg;
+    EXPECT_EQ(schedCfg.kernelBlockSize, cfg.kernelBlockSize);
+
+    cfg.kernelBlockSize = 256;
+    const ShardState shard = RunShard(request, ShardSpec{}, File("blocked"), cfg);
+    const double shardPrice = shard.discount * shard.stats.sum / static_cast<double>(shard.stats.count);
+
+    schedCfg.workers = 1;
+    schedCfg.pathsPerBlock = cfg.pathsPerBlock;
+    {
+        JobScheduler pathByPath(schedCfg);
+        EXPECT_NE(pathByPath.Submit(request).get().result.price, shardPrice);
+    }
+    schedCfg.kernelBlockSize = cfg.kernelBlockSize;
+    JobScheduler blocked(schedCfg);
+    EXPECT_NEAR(blocked.Submit(request).get().result.price, shardPrice, 1e-12 * shardPrice);
+}
+
+TEST_F(ShardRunTest, ResumesExactlyFromCheckpoint) {
+    const ShardState full = RunShard(request, ShardSpec{1, 2}, File("full"), cfg);
+
+    // Stop after the first checkpoint, then rerun on the same file
+    ShardRunConfig interrupted = cfg;
+    interrupted.checkpointSeconds = 0.0;
+    interrupted.control = std::make_shared<SimulationControl>();
+    interrupted.onCheckpoint = [ctl = interrupted.control](const ShardState&) { ctl->Cancel(); };
+    const ShardState partial = RunShard(request, ShardSpec{1, 2}, File("resumed"), interrupted);
+    EXPECT_FALSE(partial.Complete());
+    EXPECT_EQ(partial.nextBlock, partial.firstBlock + 1);
+    EXPECT_EQ(LoadShardState(File("resumed"))->stats.count, cfg.pathsPerBlock);
+
+    const ShardState resumed = RunShard(request, ShardSpec{1, 2}, File("resumed"), cfg);
+    EXPECT_TRUE(resumed.Complete());
+    EXPECT_EQ(resumed.stats.count, full.stats.count);
+    EXPECT_DOUBLE_EQ(resumed.stats.sum, full.stats.sum);
+    EXPECT_DOUBLE_EQ(resumed.stats.squaredSum, full.stats.squaredSum);
+
+    // A checkpoint only resumes the run that wrote it
+    auto other = request;
+    other.option.K = 105.0;
+    EXPECT_THROW(RunShard(other, ShardSpec{1, 2}, File("resumed"), cfg), std::runtime_error);
+
+    // ... with the kernel block size and precision it was written with
+    ShardRunConfig blocked = cfg;
+    blocked.kernelBlockSize = 64;
+    EXPECT_THROW(RunShard(request, ShardSpec{1, 2}, File("resumed"), blocked), std::runtime_error);
+    ShardRunConfig single = cfg;
+    single.precision = Precision::Single;
+    EXPECT_THROW(RunShard(request, ShardSpec{1, 2}, File("resumed"), single), std::runtime_error);
+    EXPECT_EQ(LoadShardState(File("resumed"))->kernelBlockSize, cfg.kernelBlockSize);
+}
+
+TEST_F(ShardRunTest, MergeFlagsMissingShardsAndRejectsMixedRuns) {
+    const ShardState first = RunShard(request, ShardSpec{0, 3}, File("a"), cfg);
+    const ShardMerge partial = MergeShardStates({first});
+    EXPECT_EQ(partial.result.status, PricingStatus::Cancelled);
+    EXPECT_EQ(partial.missing, (std::vector<std::uint64_t>{1, 2}));
+
+    auto other = request;
+    other.seed = 30;
+    const ShardState foreign = RunShard(other, ShardSpec{1, 3}, File("b"), cfg);
+    EXPECT_THROW(MergeShardStates({first, foreign}), std::runtime_error);
+    EXPECT_THROW(MergeShardStates({first, first}), std::runtime_error);
+
+    // A file claiming a huge shard count lists a bounded number of gaps
+    ShardState claimed = first;
+    claimed.shard.count = std::uint64_t{1} << 62;
+    const ShardMerge huge = MergeShardStates({claimed});
+    EXPECT_EQ(huge.missingCount, claimed.shard.count - 1);
+    EXPECT_EQ(huge.missing.size(), MaxListedMissing);
+    EXPECT_EQ(huge.missing.front(), 1u);
+}
+
+TEST_F(ShardRunTest, PathCountsAre64Bit) {
+    auto pricer = MakePricer(request);
+    pricer->MergeStatistics(PathStatistics{1.0, 1.0, 3'000'000'000});
+    pricer->MergeStatistics(PathStatistics{1.0, 1.0, 3'000'000'000});
+    EXPECT_EQ(pricer->PathCount(), 6'000'000'000);
+    EXPECT_TRUE(ValidRequest(PricingRequest{request.option, PayoffStyle::European, SchemeType::Euler,
+                                            10, 5'000'000'000, 1}));
+}
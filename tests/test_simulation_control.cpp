@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "CompositePricer.hpp"
+#include "HubTestUtil.hpp"
+#include "JobScheduler.hpp"
+#include "SimulationControl.hpp"
+
+class SimulationControlTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.option.T = 0.5;
+        request.scheme = SchemeType::Euler;
+        request.NT = 20;
+        request.NSIM = 5000;
+        request.seed = 7;
+    }
+
+    // Runs one hub with the control attached; returns the hub's path count
+    std::int64_t RunHub(const std::shared_ptr<SimulationControl>& control, size_t blockSize,
+                        std::shared_ptr<Pricer>& pricer, bool& stopped) {
+        pricer = MakePricer(request);
+        const auto hub = RunTestHub(request, pricer, blockSize, [&](TestHub<>& h) { h.AttachControl(control); });
+        stopped = hub->Stopped();
+        return hub->PathsSimulated();
+    }
+
+    PricingRequest request;
+};
+
+TEST_F(SimulationControlTest, PublishesEveryPathAndTheRunningEstimate) {
+    for (size_t blockSize : {size_t{0}, size_t{256}}) {
+        auto control = std::make_shared<SimulationControl>();
+        std::shared_ptr<Pricer> pricer;
+        bool stopped = true;
+        EXPECT_EQ(RunHub(control, blockSize, pricer, stopped), request.NSIM);
+        EXPECT_FALSE(stopped);
+        EXPECT_EQ(control->Paths(), request.NSIM);
+        EXPECT_EQ(control->Statistics().count, request.NSIM);
+        EXPECT_NEAR(control->Statistics().sum, pricer->Statistics().sum, 1e-9 * pricer->Statistics().sum);
+    }
+}
+
+TEST_F(SimulationControlTest, CompositePricerPublishesTheBookPayoff) {
+    auto call = MakePricer(request);
+    auto put = request;
+    put.option.type = -1;
+    auto putPricer = MakePricer(put);
+    std::shared_ptr<Pricer> book = std::make_shared<CompositePricer>(std::vector<std::shared_ptr<Pricer>>{call, putPricer});
+
+    auto control = std::make_shared<SimulationControl>();
+    RunTestHub(request, book, 0, [&](TestHub<>& h) { h.AttachControl(control); });
+    EXPECT_EQ(control->Statistics().count, request.NSIM);
+    const double children = call->Statistics().sum + putPricer->Statistics().sum;
+    EXPECT_NEAR(control->Statistics().sum, children, 1e-9 * children);
+}
+
+TEST_F(SimulationControlTest, CancelledOrExpiredRunStopsAtBlockBoundary) {
+    auto cancelled = std::make_shared<SimulationControl>();
+    cancelled->Cancel();
+    std::shared_ptr<Pricer> pricer;
+    bool stopped = false;
+    EXPECT_EQ(RunHub(cancelled, 256, pricer, stopped), 0);
+    EXPECT_TRUE(stopped);
+    EXPECT_EQ(pricer->PathCount(), 0);
+
+    auto expired = std::make_shared<SimulationControl>();
+    expired->SetDeadline(SimulationControl::Clock::now() - std::chrono::seconds(1));
+    EXPECT_EQ(RunHub(expired, 0, pricer, stopped), 0);
+    EXPECT_TRUE(stopped);
+}
+
+TEST_F(SimulationControlTest, SchedulerReportsCancelledJobs) {
+    JobScheduler::Config cfg;
+    cfg.workers = 2;
+    cfg.pathsPerBlock = 500;
+    JobScheduler scheduler(cfg);
+
+    auto control = std::make_shared<SimulationControl>();
+    control->Cancel();
+    const JobResult cancelled = scheduler.Submit(request, {}, control).get();
+    EXPECT_EQ(cancelled.result.status, PricingStatus::Cancelled);
+    EXPECT_LT(cancelled.result.paths, request.NSIM);
+
+    auto live = std::make_shared<SimulationControl>();
+    const JobResult done = scheduler.Submit(request, {}, live).get();
+    EXPECT_EQ(done.result.status, PricingStatus::Ok);
+    EXPECT_EQ(live->Paths(), request.NSIM);
+    EXPECT_NEAR(live->Sample().estimate, done.result.price, 1e-9 * done.result.price);
+}
+
+TEST_F(SimulationControlTest, ReporterDeliversFinalSample) {
+    auto control = std::make_shared<SimulationControl>();
+    control->SetTarget(10);
+    std::mutex mtx;
+    std::vector<ProgressSample> samples;
+    {
+        ProgressReporter reporter(control, std::chrono::milliseconds(1), [&](const ProgressSample& s) {
+            std::lock_guard<std::mutex> lock(mtx);
+            samples.push_back(s);
+        });
+        control->Record(10, PathStatistics{20.0, 40.0, 10});
+    }
+    ASSERT_FALSE(samples.empty());
+    EXPECT_EQ(samples.back().paths, 10);
+    EXPECT_EQ(samples.back().target, 10);
+    EXPECT_DOUBLE_EQ(samples.back().estimate, 2.0);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include "HubTestUtil.hpp"
+#include "StratifiedSampling.hpp"
+
+class StratifiedSamplingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request.option = TestOption();
+        request.scheme = SchemeType::PredictorCorrector;
+        request.NT = 50;
+        request.NSIM = 20000;
+        request.seed = 5;
+    }
+
+    struct Estimate {
+        double price;
+        double se;
+    };
+
+    Estimate Run(std::optional<StratificationConfig> strat) {
+        auto pricer = MakePricer(request);
+        const auto hub = RunTestHub(request, pricer, 256, [&](TestHub<>& h) { h.SetStratification(strat); });
+        const double df = std::exp(-request.option.r * request.option.T);
+        EXPECT_EQ(pricer->PathCount(), request.NSIM);
+        if (!strat) {
+            return {pricer->OptionPrice(), df * std::get<1>(pricer->StandardDeviationStats())};
+        }
+        EXPECT_EQ(hub->Stratified().Paths(), request.NSIM);
+        return {hub->Stratified().Price(df), hub->Stratified().StdErr(df)};
+    }
+
+    PricingRequest request;
+    static constexpr double BlackScholesCall = 10.450583572185565;
+};
+
+TEST(InverseNormalCDFTest, MatchesKnownQuantiles) {
+    EXPECT_NEAR(InverseNormalCDF(0.5), 0.0, 1e-15);
+    EXPECT_NEAR(InverseNormalCDF(0.975), 1.959963984540054, 1e-12);
+    EXPECT_NEAR(InverseNormalCDF(0.001), -3.090232306167813, 1e-12);
+    EXPECT_NEAR(InverseNormalCDF(1e-9), -5.997807015007686, 1e-10);
+    EXPECT_NEAR(InverseNormalCDF(0.8), -InverseNormalCDF(0.2), 1e-14);
+}
+
+TEST(AllocatePathsTest, SplitsExactlyInProportion) {
+    const auto even = AllocatePaths(10, std::vector<double>(4, 1.0), 0);
+    EXPECT_EQ(std::accumulate(even.begin(), even.end(), std::int64_t{0}), 10);
+    for (auto n : even) EXPECT_TRUE(n == 2 || n == 3);
+
+    const auto skewed = AllocatePaths(100, {0.0, 1.0, 3.0}, 2);
+    EXPECT_EQ(skewed, (std::vector<std::int64_t>{2, 26, 72}));
+
+    const auto zero = AllocatePaths(9, {0.0, 0.0, 0.0}, 0);
+    EXPECT_EQ(zero, (std::vector<std::int64_t>{3, 3, 3}));
+}
+
+TEST(AllocatePathsTest, NeymanTopUpCountsThePilot) {
+    // A small pilot: pilot plus main run is exactly the Neyman allocation
+    EXPECT_EQ(NeymanTopUp(100, {2, 2, 2}, {0.0, 1.0, 3.0}), (std::vector<std::int64_t>{0, 24, 70}));
+
+    // The pilot oversampled stratum 0; the rest is shared by the shortfall
+    const auto topUp = NeymanTopUp(100, {10, 10, 10}, {0.0, 1.0, 3.0});
+    EXPECT_EQ(topUp, (std::vector<std::int64_t>{0, 14, 56}));
+}
+
+TEST_F(StratifiedSamplingTest, StratifiedCallIsAccurateWithSmallerError) {
+    const Estimate plain = Run(std::nullopt);
+    const Estimate strat = Run(StratificationConfig{.strata = 100});
+    EXPECT_NEAR(strat.price, BlackScholesCall, 4.0 * strat.se + 0.02);
+    EXPECT_LT(strat.se, 0.3 * plain.se);
+
+    const Estimate optimal = Run(StratificationConfig{.strata = 100, .allocation = StrataAllocation::Optimal});
+    EXPECT_NEAR(optimal.price, BlackScholesCall, 4.0 * optimal.se + 0.02);
+    EXPECT_LT(optimal.se, strat.se);
+}
+
+TEST_F(StratifiedSamplingTest, BridgeKeepsPathDependentPricesUnbiased) {
+    request.style = PayoffStyle::Asian;
+    const Estimate plain = Run(std::nullopt);
+    const Estimate strat = Run(StratificationConfig{.strata = 50});
+    EXPECT_NEAR(strat.price, plain.price, 4.0 * std::hypot(plain.se, strat.se));
+}
+
+TEST_F(StratifiedSamplingTest, StrataAreCappedAtTwoPathsEach) {
+    request.NSIM = 2001;
+    const auto hub = RunTestHub(request, MakePricer(request), 0, [](TestHub<>& h) {
+        h.SetStratification(StratificationConfig{.strata = 5000});
+    });
+    ASSERT_EQ(hub->Stratified().strata.size(), 1000u);
+    for (const auto& stratum : hub->Stratified().strata) {
+        EXPECT_GE(stratum.count, 2);
+    }
+
+    hub->SetPrecision(Precision::Single);
+    EXPECT_THROW(hub->BeginSimulation(), std::runtime_error);
+
+    request.NSIM = 1;
+    const auto single = MakeTestHub(request, MakePricer(request), 0);
+    single->SetStratification(StratificationConfig{});
+    EXPECT_THROW(single->BeginSimulation(), std::runtime_error);
+}
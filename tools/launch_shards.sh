@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+# Usage: tools/launch_shards.sh <shards> <out_dir> [mc_shard options...]
+#
+# Runs shards 0..n-1 of one pricing as local mc_shard processes, waits for
+# them and merges their files with mc_merge. Rerunning the same command
+# resumes unfinished shards from their checkpoints. For several machines, run
+# the mc_shard lines by hand (same options, one --shard each), copy the
+# shard files to one place and run mc_merge on them.
+#
+# MC_BIN_DIR selects the directory holding mc_shard and mc_merge (default: build).
+set -euo pipefail
+
+if [ $# -lt 2 ]; then
+    sed -n '2,9p' "$0" | sed 's/^# \{0,1\}//'
+    exit 1
+fi
+
+shards=$1
+out_dir=$2
+shift 2
+bin_dir=${MC_BIN_DIR:-build}
+
+mkdir -p "$out_dir"
+pids=()
+files=()
+for ((i = 0; i < shards; i++)); do
+    file="$out_dir/shard_${i}_of_${shards}.mcs"
+    files+=("$file")
+    "$bin_dir/mc_shard" --shard "$i/$shards" --out "$file" "$@" > "$out_dir/shard_${i}_of_${shards}.log" 2>&1 &
+    pids+=($!)
+done
+
+# Forward Ctrl-C so every shard stops with its checkpoint written
+trap 'kill -TERM "${pids[@]}" 2>/dev/null' INT TERM
+
+failed=0
+for pid in "${pids[@]}"; do
+    wait "$pid" || failed=1
+done
+cat "$out_dir"/shard_*_of_"${shards}".log
+
+"$bin_dir/mc_merge" "${files[@]}" || failed=1
+exit $failed
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AnalyticPrices.hpp"
+#include "GeometricAsianPricer.hpp"
+#include "ImportanceSampling.hpp"
+#include "MCCentralHub.hpp"
+#include "PerfCounters.hpp"
+#include "PricingEngine.hpp"
+
+// Usage: mc_efficiency [--quick] [--target rmse] [--reps n] [--csv file] [--counters]
+//
+// Sweeps scheme, NT, NSIM, generator precision and variance reduction for an
+// at-the-money European call and a geometric Asian call, compares each
+// configuration with its closed form over several seeds and writes bias, SE,
+// RMSE, CPU seconds and efficiency (RMSE^2 x time, lower is better) as CSV.
+// --counters adds hardware counters per path where perf events are
+// available; it is off by default so the timings cover the unprofiled code.
+// Ends with the Pareto front (time vs RMSE) and the cheapest configuration
+// meeting the target RMSE per product.
+
+namespace {
+
+enum class Product { European, GeometricAsian };
+enum class Variance { None, Stratified, DriftShift };
+
+struct Setting {
+    Product product;
+    SchemeType scheme;
+    int NT;
+    int NSIM;
+    Precision precision;
+    Variance variance;
+};
+
+struct Row {
+    Setting s;
+    double exact, mean, bias, se, rmse, seconds, efficiency;
+    PerfSample counters;     // summed over phases and replications
+    std::int64_t paths;
+};
+
+const char* Name(Product p) { return p == Product::European ? "european_call" : "geometric_asian_call"; }
+const char* Name(SchemeType s) {
+    switch (s) {
+    case SchemeType::Euler: return "euler";
+    case SchemeType::LogEuler: return "log_euler";
+    default: return "predictor_corrector";
+    }
+}
+const char* Name(Precision p) { return p == Precision::Single ? "mt19937_f32" : "mt19937_f64"; }
+const char* Name(Variance v) {
+    switch (v) {
+    case Variance::Stratified: return "stratified";
+    case Variance::DriftShift: return "drift_shift";
+    default: return "none";
+    }
+}
+
+OptionData AtTheMoneyCall() {
+    return OptionData{
+        .K = 100.0,        // Strike price
+        .T = 1.0,          // Time to maturity
+        .r = 0.05,         // Risk-free rate
+        .sig = 0.2,        // Volatility
+        .D = 0.0,          // Dividend rate
+        .S_0 = 100.0,      // Initial stock price
+        .type = 1,         // Call option
+        .H = 0.0,          // No barrier
+        .betaCEV = 1.0,    // Standard CEV parameter
+        .scale = 1.0       // Standard scale
+    };
+}
+
+Row Measure(const Setting& s, int reps, bool counters) {
+    const OptionData o = AtTheMoneyCall();
+    const double exact = s.product == Product::European
+        ? BlackScholesPrice(o)
+        : GeometricAsianPrice(o, UniformAsianFixings(o.T, s.NT));
+    const double df = std::exp(-o.r * o.T);
+
+    double sum = 0.0, sumSq = 0.0, seSum = 0.0, cpu = 0.0;
+    auto profile = counters ? std::make_shared<PerfProfile>() : nullptr;
+    for (int rep = 0; rep < reps; ++rep) {
+        auto sde = MakeSDE(o);
+        auto fdm = MakeFDM(sde, s.scheme, s.NT);
+        auto payoff = MakePayoff(o);
+        std::function<double()> discount = [df]() { return df; };
+        std::shared_ptr<Pricer> pricer;
+        if (s.product == Product::European) {
+            pricer = std::make_shared<EuropeanOptionPricer>(payoff, discount);
+        }
+        else {
+            pricer = std::make_shared<GeometricAsianPricer>(payoff, discount);
+        }
+        auto rng = std::make_shared<MTEngRandNumGen>(static_cast<std::uint64_t>(rep + 1));
+        auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, s.NSIM);
+        hub.SetVerbose(false);
+        hub.SetBlockSize(256);
+        hub.SetPrecision(s.precision);
+        hub.AttachProfile(profile);
+
+        const std::clock_t start = std::clock();
+        if (s.variance == Variance::Stratified) {
+            hub.SetStratification(StratificationConfig{.strata = static_cast<size_t>(std::max(1, s.NSIM / 32))});
+        }
+        else if (s.variance == Variance::DriftShift) {
+            hub.SetDriftShift(AnalyticDriftShift(*sde, o.K, o.type));
+        }
+        hub.BeginSimulation();
+        cpu += static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+
+        double price = pricer->OptionPrice();
+        double se = df * std::get<1>(pricer->StandardDeviationStats());
+        if (s.variance == Variance::Stratified) {
+            price = hub.Stratified().Price(df);
+            se = hub.Stratified().StdErr(df);
+        }
+        sum += price;
+        sumSq += (price - exact) * (price - exact);
+        seSum += se;
+    }
+
+    Row row{s, exact, 0, 0, 0, 0, 0, 0, {}, 0};
+    if (profile) {
+        row.counters.valid.fill(true);
+        for (const auto& phase : profile->PhaseTotals()) {
+            row.counters += phase.counters;
+        }
+    }
+    row.paths = static_cast<std::int64_t>(s.NSIM) * reps;
+    const double R = static_cast<double>(reps);
+    row.mean = sum / R;
+    row.bias = row.mean - exact;
+    row.se = seSum / R;
+    row.rmse = std::sqrt(sumSq / R);
+    row.seconds = cpu / R;
+    row.efficiency = row.rmse * row.rmse * row.seconds;
+    return row;
+}
+
+void WriteCsv(std::ostream& out, const std::vector<Row>& rows) {
+    out << "product,scheme,rng,variance,NT,NSIM,exact,mean,bias,se,rmse,cpu_seconds,efficiency,"
+           "cycles_per_path,instructions_per_path,branch_misses_per_path,llc_misses_per_path\n";
+    for (const auto& r : rows) {
+        out << Name(r.s.product) << ',' << Name(r.s.scheme) << ',' << Name(r.s.precision) << ','
+            << Name(r.s.variance) << ',' << r.s.NT << ',' << r.s.NSIM << ',' << r.exact << ','
+            << r.mean << ',' << r.bias << ',' << r.se << ',' << r.rmse << ',' << r.seconds << ','
+            << r.efficiency;
+        for (PerfEvent e : {PerfEvent::Cycles, PerfEvent::Instructions, PerfEvent::BranchMisses, PerfEvent::LLCMisses}) {
+            out << ',';
+            if (r.counters.Has(e)) out << static_cast<double>(r.counters[e]) / static_cast<double>(r.paths);
+        }
+        out << '\n';
+    }
+}
+
+void Describe(const Row& r) {
+    std::cerr << "  " << Name(r.s.scheme) << ' ' << Name(r.s.precision) << ' ' << Name(r.s.variance)
+              << " NT=" << r.s.NT << " NSIM=" << r.s.NSIM << ": rmse " << r.rmse
+              << ", " << r.seconds << " s\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    double target = 0.05;
+    int reps = 4;
+    std::string csvPath;
+    bool counters = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--quick") quick = true;
+        else if (arg == "--target" && i + 1 < argc) target = std::strtod(argv[++i], nullptr);
+        else if (arg == "--reps" && i + 1 < argc) reps = std::max(2, std::atoi(argv[++i]));
+        else if (arg == "--csv" && i + 1 < argc) csvPath = argv[++i];
+        else if (arg == "--counters") counters = true;
+        else {
+            std::cerr << "Usage: mc_efficiency [--quick] [--target rmse] [--reps n] [--csv file] [--counters]\n";
+            return 1;
+        }
+    }
+
+    const std::vector<int> steps = quick ? std::vector<int>{16, 64} : std::vector<int>{16, 64, 256};
+    const std::vector<int> paths = quick ? std::vector<int>{2000, 8000} : std::vector<int>{4000, 16000, 64000};
+
+    std::vector<Row> rows;
+    for (Product product : {Product::European, Product::GeometricAsian}) {
+        for (SchemeType scheme : {SchemeType::Euler, SchemeType::PredictorCorrector, SchemeType::LogEuler}) {
+            for (Precision precision : {Precision::Double, Precision::Single}) {
+                for (Variance variance : {Variance::None, Variance::Stratified, Variance::DriftShift}) {
+                    // Stratified paths are always simulated in double
+                    if (variance == Variance::Stratified && precision == Precision::Single) continue;
+                    for (int NT : steps) {
+                        for (int NSIM : paths) {
+                            rows.push_back(Measure(Setting{product, scheme, NT, NSIM, precision, variance}, reps, counters));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (csvPath.empty()) {
+        WriteCsv(std::cout, rows);
+    }
+    else {
+        std::ofstream out(csvPath);
+        WriteCsv(out, rows);
+    }
+
+    for (Product product : {Product::European, Product::GeometricAsian}) {
+        std::vector<Row> front;
+        for (const auto& r : rows) {
+            if (r.s.product == product) front.push_back(r);
+        }
+        std::sort(front.begin(), front.end(), [](const Row& a, const Row& b) { return a.seconds < b.seconds; });
+
+        std::cerr << "\nPareto front (CPU time vs RMSE), " << Name(product) << ":\n";
+        double best = INFINITY;
+        const Row* cheapest = nullptr;
+        for (const auto& r : front) {
+            if (r.rmse < best) {
+                best = r.rmse;
+                Describe(r);
+                if (!cheapest && r.rmse <= target) cheapest = &r;
+            }
+        }
+        std::cerr << "Cheapest configuration with RMSE <= " << target << ":\n";
+        if (cheapest) Describe(*cheapest);
+        else std::cerr << "  none in this sweep\n";
+    }
+    return 0;
+}
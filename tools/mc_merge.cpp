@@ -0,0 +1,35 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ShardRun.hpp"
+
+// Usage: mc_merge shard_file...
+// Prints the combined price, SD, SE and path count of one sharded run.
+// Exit status 0 when every shard is present and complete, 2 otherwise.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: mc_merge shard_file...\n";
+        return 1;
+    }
+    const std::vector<std::string> files(argv + 1, argv + argc);
+
+    ShardMerge merged;
+    try {
+        merged = MergeShardFiles(files);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "mc_merge: " << e.what() << '\n';
+        return 1;
+    }
+
+    std::cout << "Price: " << merged.result.price << '\n'
+              << "SD: " << merged.result.stdDev << '\n'
+              << "SE: " << merged.result.stdErr << '\n'
+              << "Paths: " << merged.result.paths << '\n';
+    for (auto i : merged.missing) std::cout << "Missing shard " << i << '\n';
+    if (merged.missingCount > merged.missing.size()) {
+        std::cout << "... " << merged.missingCount - merged.missing.size() << " more shards missing\n";
+    }
+    for (auto i : merged.incomplete) std::cout << "Incomplete shard " << i << '\n';
+    return merged.result.status == PricingStatus::Ok ? 0 : 2;
+}
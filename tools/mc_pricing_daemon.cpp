@@ -0,0 +1,43 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <pthread.h>
+#include "PricingService.hpp"
+
+// Usage: mc_pricing_daemon [socket_path] [workers] [coalesce_us] [cache_dir]
+// Results are cached in memory, and under cache_dir when given.
+// Runs until SIGINT/SIGTERM.
+int main(int argc, char* argv[]) {
+    PricingService::Config cfg;
+    cfg.socketPath = argc > 1 ? argv[1] : "/tmp/mc_pricing.sock";
+    if (argc > 2) cfg.workers = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+    if (argc > 3) cfg.coalesceWindow = std::chrono::microseconds(std::strtol(argv[3], nullptr, 10));
+    cfg.cache = std::make_shared<ResultCache>(4096, argc > 4 ? argv[4] : "");
+
+    // Block termination signals in every thread; main waits for them below
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    PricingService service(cfg);
+    try {
+        service.Start();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "mc_pricing_daemon: " << e.what() << '\n';
+        return 1;
+    }
+    std::cout << "Pricing service listening on " << cfg.socketPath << '\n';
+
+    int sig = 0;
+    sigwait(&signals, &sig);
+
+    service.Stop();
+    std::cout << "Served " << service.RequestsServed() << " requests in "
+              << service.SimulationsRun() << " simulations, "
+              << cfg.cache->Hits() << " cache hits\n";
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "MCCentralHub.hpp"
+#include "NumaTopology.hpp"
+#include "PricingEngine.hpp"
+#include "RngPipeline.hpp"
+
+// Usage: mc_rng_pipeline [--quick] [--paths n] [--steps n] [--reps n] [--cpu c]
+//
+// Times block-mode runs with normals drawn inline against the pipelined RNG
+// (producer thread and SPSC ring) over kernel precision, path block size and
+// ring chunk size. Writes wall seconds, path steps/s, the speed-up over the
+// inline run of the same block setup and the ring stalls of each side as CSV.
+// With --cpu c the stepping thread runs on CPU c and the producer on an SMT
+// sibling of c when the host has one, otherwise on the next allowed CPU.
+
+namespace {
+
+struct Row {
+    Precision precision;
+    size_t block;
+    size_t chunkKiB;          // 0 = inline generation
+    double seconds;
+    double stepsPerSecond;
+    double speedup;
+    RngPipelineStats stats;
+};
+
+PricingRequest BenchmarkRequest(std::int64_t paths, int steps) {
+    PricingRequest req;
+    req.option = OptionData{
+        .K = 100.0,        // Strike price
+        .T = 1.0,          // Time to maturity
+        .r = 0.05,         // Risk-free rate
+        .sig = 0.2,        // Volatility
+        .D = 0.0,          // Dividend rate
+        .S_0 = 100.0,      // Initial stock price
+        .type = 1,         // Call option
+        .H = 0.0,          // No barrier
+        .betaCEV = 1.0,    // Standard CEV parameter
+        .scale = 1.0       // Standard scale
+    };
+    req.style = PayoffStyle::European;
+    req.scheme = SchemeType::PredictorCorrector;
+    req.NT = steps;
+    req.NSIM = paths;
+    req.seed = 1;
+    return req;
+}
+
+// Another hardware thread of cpu's core, or -1
+int SmtSibling(int cpu) {
+    std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+    std::string list;
+    if (!std::getline(in, list)) return -1;
+    for (int c : NumaTopology::ParseCpuList(list)) {
+        if (c != cpu) return c;
+    }
+    return -1;
+}
+
+// Best-of-reps wall time of one configuration
+Row Measure(const PricingRequest& req, Precision precision, size_t block, std::optional<RngPipelineConfig> pipeline,
+            int reps) {
+    auto sde = MakeSDE(req.option);
+    auto fdm = MakeFDM(sde, req.scheme, req.NT);
+    Row row{precision, block, pipeline ? pipeline->chunkBytes / 1024 : 0, 0.0, 0.0, 1.0, {}};
+    double best = 0.0;
+    for (int r = 0; r < reps; ++r) {
+        std::shared_ptr<Pricer> pricer = MakePricer(req);
+        auto rng = std::make_shared<MTEngRandNumGen>(req.seed);
+        auto pieces = std::make_tuple(sde, pricer, fdm, rng);
+        MCCentralHub<SDEGeneral, Pricer, FDMType, MTEngRandNumGen> hub(pieces, req.NSIM);
+        hub.SetVerbose(false);
+        hub.SetBlockSize(block);
+        hub.SetPrecision(precision);
+        hub.SetRngPipeline(pipeline);
+        const auto start = std::chrono::steady_clock::now();
+        hub.BeginSimulation();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (r == 0 || seconds < best) {
+            best = seconds;
+            row.stats = hub.PipelineStats();
+        }
+    }
+    row.seconds = best;
+    row.stepsPerSecond = static_cast<double>(req.NSIM) * static_cast<double>(req.NT) / std::max(best, 1e-9);
+    return row;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    std::int64_t paths = 200000;
+    int steps = 100;
+    int reps = 3;
+    int cpu = -1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--quick") quick = true;
+        else if (arg == "--paths" && i + 1 < argc) paths = std::max<std::int64_t>(1, std::atoll(argv[++i]));
+        else if (arg == "--steps" && i + 1 < argc) steps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--reps" && i + 1 < argc) reps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--cpu" && i + 1 < argc) cpu = std::atoi(argv[++i]);
+        else {
+            std::cerr << "Usage: mc_rng_pipeline [--quick] [--paths n] [--steps n] [--reps n] [--cpu c]\n";
+            return 1;
+        }
+    }
+    if (quick) paths = std::min<std::int64_t>(paths, 50000);
+
+    int producerCpu = -1;
+    if (cpu >= 0) {
+        if (!PinCurrentThread(cpu)) {
+            std::cerr << "Cannot run on CPU " << cpu << '\n';
+            return 1;
+        }
+        producerCpu = SmtSibling(cpu);
+        if (producerCpu < 0) {
+            const NumaTopology topology = NumaTopology::Detect();
+            for (const auto& node : topology.Nodes()) {
+                for (int c : node.cpus) {
+                    if (producerCpu < 0 && c != cpu) producerCpu = c;
+                }
+            }
+        }
+        std::cerr << "Stepping on CPU " << cpu << ", producer on CPU " << producerCpu
+                  << (producerCpu == SmtSibling(cpu) && producerCpu >= 0 ? " (SMT sibling)" : "") << '\n';
+    }
+
+    const PricingRequest req = BenchmarkRequest(paths, steps);
+    const std::vector<size_t> blocks = quick ? std::vector<size_t>{256} : std::vector<size_t>{128, 512, 2048};
+    const std::vector<size_t> chunks = quick ? std::vector<size_t>{64} : std::vector<size_t>{16, 64, 256};
+
+    std::vector<Row> rows;
+    for (Precision precision : {Precision::Double, Precision::Single}) {
+        for (size_t block : blocks) {
+            const Row inlineRow = Measure(req, precision, block, std::nullopt, reps);
+            rows.push_back(inlineRow);
+            for (size_t kib : chunks) {
+                RngPipelineConfig cfg;
+                cfg.chunkBytes = kib * 1024;
+                cfg.producerCpu = producerCpu;
+                Row row = Measure(req, precision, block, cfg, reps);
+                row.speedup = inlineRow.seconds / std::max(row.seconds, 1e-12);
+                rows.push_back(row);
+            }
+        }
+    }
+
+    std::cout << "kernel,block,rng,chunk_kib,seconds,path_steps_per_s,speedup,chunks,producer_stalls,consumer_stalls\n";
+    for (const Row& r : rows) {
+        std::cout << (r.precision == Precision::Single ? "float32" : "float64") << ',' << r.block << ','
+                  << (r.chunkKiB == 0 ? "inline" : "pipelined") << ',' << r.chunkKiB << ','
+                  << r.seconds << ',' << r.stepsPerSecond << ',' << r.speedup << ','
+                  << r.stats.chunks << ',' << r.stats.producerStalls << ',' << r.stats.consumerStalls << '\n';
+    }
+
+    // Best pipelined row; every sweep has at least one
+    const auto best = std::max_element(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        return (a.chunkKiB == 0 ? 0.0 : a.speedup) < (b.chunkKiB == 0 ? 0.0 : b.speedup);
+    });
+    std::cerr << "Best pipelined speed-up " << best->speedup << "x ("
+              << (best->precision == Precision::Single ? "float32" : "float64") << ", block " << best->block
+              << ", " << best->chunkKiB << " KiB chunks)\n";
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <pthread.h>
+#include "ShardRun.hpp"
+
+// Usage: mc_shard --shard i/n --out file [--paths N] [--seed S] [--nt NT]
+//                 [--block paths] [--checkpoint seconds] [--euler | --log-euler] [--asian] [--put]
+//                 [--S0 x] [--K x] [--T x] [--r x] [--sig x] [--div x] [--beta x]
+//
+// Runs shard i of n of one pricing request, checkpointing to the output file.
+// Rerunning the same command resumes from the file. SIGINT/SIGTERM stop after
+// the current block with the checkpoint written. Exit status 0 when the shard
+// is complete, 3 when it stopped early. Combine shard files with mc_merge.
+
+namespace {
+
+int Usage() {
+    std::cerr << "Usage: mc_shard --shard i/n --out file [--paths N] [--seed S] [--nt NT] [--block paths]\n"
+                 "                [--checkpoint seconds] [--euler | --log-euler] [--asian] [--put]\n"
+                 "                [--S0 x] [--K x] [--T x] [--r x] [--sig x] [--div x] [--beta x]\n";
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    PricingRequest request;
+    request.option = OptionData{
+        .K = 100.0,        // Strike price
+        .T = 1.0,          // Time to maturity
+        .r = 0.05,         // Risk-free rate
+        .sig = 0.2,        // Volatility
+        .D = 0.0,          // Dividend rate
+        .S_0 = 100.0,      // Initial stock price
+        .type = 1,         // Call option
+        .H = 0.0,          // No barrier
+        .betaCEV = 1.0,    // Standard CEV parameter
+        .scale = 1.0       // Standard scale
+    };
+    request.NT = 252;
+    request.NSIM = 10'000'000;
+    request.seed = 1;
+
+    ShardSpec shard;
+    std::string out;
+    ShardRunConfig cfg;
+    const std::map<std::string, double*> numbers = {
+        {"--S0", &request.option.S_0}, {"--K", &request.option.K}, {"--T", &request.option.T},
+        {"--r", &request.option.r}, {"--sig", &request.option.sig}, {"--div", &request.option.D},
+        {"--beta", &request.option.betaCEV}, {"--checkpoint", &cfg.checkpointSeconds}};
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--euler") request.scheme = SchemeType::Euler;
+            else if (arg == "--log-euler") request.scheme = SchemeType::LogEuler;
+            else if (arg == "--asian") request.style = PayoffStyle::Asian;
+            else if (arg == "--put") request.option.type = -1;
+            else if (!hasValue) return Usage();
+            else if (arg == "--shard") shard = ShardSpec::Parse(argv[++i]);
+            else if (arg == "--out") out = argv[++i];
+            else if (arg == "--paths") request.NSIM = std::strtoll(argv[++i], nullptr, 10);
+            else if (arg == "--seed") request.seed = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--nt") request.NT = static_cast<std::int32_t>(std::strtol(argv[++i], nullptr, 10));
+            else if (arg == "--block") cfg.pathsPerBlock = std::strtoll(argv[++i], nullptr, 10);
+            else if (auto it = numbers.find(arg); it != numbers.end()) *it->second = std::strtod(argv[++i], nullptr);
+            else return Usage();
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "mc_shard: " << e.what() << '\n';
+        return 1;
+    }
+    if (out.empty()) return Usage();
+
+    // Termination signals cancel the run; SIGUSR1 only releases the watcher
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    cfg.control = std::make_shared<SimulationControl>();
+    std::thread watcher([&signals, control = cfg.control] {
+        int sig = 0;
+        sigwait(&signals, &sig);
+        if (sig != SIGUSR1) control->Cancel();
+    });
+
+    int status = 0;
+    try {
+        const ShardState state = RunShard(request, shard, out, cfg);
+        const double se = std::get<1>(state.stats.StandardDeviationStats());
+        std::cout << "Shard " << shard.index << '/' << shard.count << ": blocks " << state.nextBlock - state.firstBlock
+                  << '/' << state.lastBlock - state.firstBlock << ", " << state.stats.count << " paths, price "
+                  << state.stats.Price(state.discount) << ", SE " << se << '\n';
+        status = state.Complete() ? 0 : 3;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "mc_shard: " << e.what() << '\n';
+        status = 1;
+    }
+    pthread_kill(watcher.native_handle(), SIGUSR1);
+    watcher.join();
+    return status;
+}